@@ -46,6 +46,16 @@ extern "C"{
 #define RCP_VERSION_MINOR 1
 #define RCP_VERSION_PATCH 0
 
+// protocol extensions - build metadata of the version sent in INFO
+#define RCP_EXTENSION_SUBSCRIBE "subscribe"
+#define RCP_VERSION_EXTENSIONS RCP_EXTENSION_SUBSCRIBE
+
+// specified commands and extension commands
+#define RCP_COMMAND_VALID(c) \
+    (((c) > COMMAND_INVALID && (c) < COMMAND_MAX_) \
+     || (c) == COMMAND_SUBSCRIBE \
+     || (c) == COMMAND_UNSUBSCRIBE)
+
 // version of c implementation
 #define RCP_C_VERSION "1.1.0"
 #define RCP_C_VERSION_MAJOR 1
@@ -0,0 +1,193 @@
+/*
+********************************************************************
+* RabbitControl - a protocol for remote control.
+* https://rabbitcontrol.cc
+*
+* Copyright (C) 2024, Ingo Randolf
+*
+* This file is part of RabbitControl for C (rcp-c).
+*
+* rcp-c is free software: you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License,
+* or (at your option) any later version.
+*
+* rcp-c is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+* See the GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with rcp-c. If not, see <https://www.gnu.org/licenses/>.
+*********************************************************************
+*/
+
+#include "rcp_arena.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "rcp_memory.h"
+#include "rcp_logging.h"
+
+#if defined(RCP_ARENA_DEBUG_LOG) || defined(RCP_ALL_DEBUG)
+#define RCP_ARENA_DEBUG(...) RCP_DEBUG(__VA_ARGS__)
+#else
+#define RCP_ARENA_DEBUG(...)
+#endif
+
+#if defined(RCP_ARENA_MALLOC_DEBUG_LOG) || defined(RCP_ALL_DEBUG)
+#define RCP_ARENA_MALLOC_DEBUG(...) RCP_DEBUG(__VA_ARGS__)
+#else
+#define RCP_ARENA_MALLOC_DEBUG(...)
+#endif
+
+typedef struct rcp_arena_block rcp_arena_block;
+
+struct rcp_arena_block
+{
+    rcp_arena_block* next;
+    size_t size;
+    size_t used;
+    // data follows
+};
+
+struct rcp_arena
+{
+    rcp_arena_block* blocks;
+    size_t block_size;
+};
+
+#define RCP_ARENA_ALIGN(x) (((x) + sizeof(uint64_t) - 1) & ~(sizeof(uint64_t) - 1))
+#define RCP_ARENA_BLOCK_HEADER RCP_ARENA_ALIGN(sizeof(rcp_arena_block))
+
+
+rcp_arena* rcp_arena_create(size_t block_size)
+{
+    rcp_arena* arena = (rcp_arena*)RCP_CALLOC(1, sizeof(rcp_arena));
+
+    if (arena != NULL)
+    {
+        RCP_ARENA_MALLOC_DEBUG("*** arena: %p\n", arena);
+
+        arena->block_size = block_size > 0 ? block_size : RCP_ARENA_BLOCK_SIZE;
+    }
+    else
+    {
+        RCP_ERROR("could not create arena\n");
+    }
+
+    return arena;
+}
+
+void rcp_arena_free(rcp_arena* arena)
+{
+    if (arena == NULL) return;
+
+    rcp_arena_block* block = arena->blocks;
+    while (block != NULL)
+    {
+        rcp_arena_block* next = block->next;
+
+        RCP_ARENA_MALLOC_DEBUG("+++ arena block: %p\n", block);
+        RCP_FREE(block);
+
+        block = next;
+    }
+
+    RCP_ARENA_MALLOC_DEBUG("+++ arena: %p\n", arena);
+    RCP_FREE(arena);
+}
+
+void* rcp_arena_alloc(rcp_arena* arena, size_t size)
+{
+    if (arena == NULL) return NULL;
+    if (size > SIZE_MAX - RCP_ARENA_BLOCK_HEADER - sizeof(uint64_t)) return NULL;
+
+    size_t needed = RCP_ARENA_ALIGN(size);
+
+    // find block with space
+    rcp_arena_block* block = arena->blocks;
+    while (block != NULL &&
+           block->size - block->used < needed)
+    {
+        block = block->next;
+    }
+
+    if (block == NULL)
+    {
+        size_t block_size = needed > arena->block_size ? needed : arena->block_size;
+
+        block = (rcp_arena_block*)RCP_MALLOC(RCP_ARENA_BLOCK_HEADER + block_size);
+        if (block == NULL)
+        {
+            RCP_ERROR("could not allocate arena block\n");
+            return NULL;
+        }
+
+        RCP_ARENA_MALLOC_DEBUG("*** arena block: %p (%d)\n", block, block_size);
+
+        block->size = block_size;
+        block->used = 0;
+        block->next = arena->blocks;
+        arena->blocks = block;
+    }
+
+    char* mem = (char*)block + RCP_ARENA_BLOCK_HEADER + block->used;
+    block->used += needed;
+
+    return mem;
+}
+
+void* rcp_arena_calloc(rcp_arena* arena, size_t count, size_t size)
+{
+    if (size != 0 && count > SIZE_MAX / size)
+    {
+        RCP_ERROR("arena calloc overflow\n");
+        return NULL;
+    }
+
+    void* ptr = rcp_arena_alloc(arena, count * size);
+    if (ptr != NULL)
+    {
+        memset(ptr, 0, count * size);
+    }
+
+    return ptr;
+}
+
+void rcp_arena_reset(rcp_arena* arena)
+{
+    if (arena == NULL) return;
+
+    RCP_ARENA_DEBUG("reset arena: %p\n", arena);
+
+    rcp_arena_block* block = arena->blocks;
+    while (block != NULL)
+    {
+        block->used = 0;
+        block = block->next;
+    }
+}
+
+bool rcp_arena_owns(rcp_arena* arena, const void* ptr)
+{
+    if (arena == NULL) return false;
+    if (ptr == NULL) return false;
+
+    rcp_arena_block* block = arena->blocks;
+    while (block != NULL)
+    {
+        const char* start = (const char*)block + RCP_ARENA_BLOCK_HEADER;
+        if ((const char*)ptr >= start &&
+                (const char*)ptr < start + block->size)
+        {
+            return true;
+        }
+
+        block = block->next;
+    }
+
+    return false;
+}
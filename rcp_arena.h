@@ -0,0 +1,68 @@
+/*
+********************************************************************
+* RabbitControl - a protocol for remote control.
+* https://rabbitcontrol.cc
+*
+* Copyright (C) 2024, Ingo Randolf
+*
+* This file is part of RabbitControl for C (rcp-c).
+*
+* rcp-c is free software: you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License,
+* or (at your option) any later version.
+*
+* rcp-c is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+* See the GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with rcp-c. If not, see <https://www.gnu.org/licenses/>.
+*********************************************************************
+*/
+#ifndef RCP_ARENA_H
+#define RCP_ARENA_H
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+#include <stddef.h>
+#include <stdbool.h>
+
+//#define RCP_ARENA_DEBUG_LOG
+//#define RCP_ARENA_MALLOC_DEBUG_LOG
+
+// parse received packets of server and client into an arena
+//#define RCP_USE_ARENA
+
+// default size of arena blocks
+#ifndef RCP_ARENA_BLOCK_SIZE
+#define RCP_ARENA_BLOCK_SIZE 4096
+#endif
+
+// bump allocator for short-lived data
+// memory is released all at once with rcp_arena_reset
+// blocks are kept for reuse until the arena is freed
+//
+// the arena is passed explicitly to the parser (see rcp_packet_set_arena)
+// parameter, typedefinition and option nodes remember their arena
+// and are not freed individually
+typedef struct rcp_arena rcp_arena;
+
+// create / free
+rcp_arena* rcp_arena_create(size_t block_size);
+void rcp_arena_free(rcp_arena* arena);
+
+// memory
+void* rcp_arena_alloc(rcp_arena* arena, size_t size); // not zeroed
+void* rcp_arena_calloc(rcp_arena* arena, size_t count, size_t size); // zeroed
+void rcp_arena_reset(rcp_arena* arena); // releases all memory of arena
+bool rcp_arena_owns(rcp_arena* arena, const void* ptr);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // RCP_ARENA_H
@@ -34,6 +34,8 @@
 #include "rcp_manager.h"
 #include "rcp_parameter.h"
 #include "rcp_semver.h"
+#include "rcp_arena.h"
+#include "rcp_scanner.h"
 
 
 #if defined(RCP_CLIENT_DEBUG_LOG) || defined(RCP_ALL_DEBUG)
@@ -56,9 +58,24 @@ struct rcp_client
     char* applicationId;
     bool acceptParameter;
 
+    // discover root group instead of initializing all parameters
+    bool discover;
+
+    // server announced the subscribe extension - see rcp_client_subscribe
+    bool serverSubscribe;
+
+    // reused for parsing - NULL while in use
+    rcp_packet* receive_packet;
+
+#ifdef RCP_USE_ARENA
+    // memory of parsed packets - NULL while in use
+    rcp_arena* arena;
+#endif
+
     void (*parameterAddedCb)(rcp_parameter* parameter, void* user);
     void (*parameterRemovedCb)(rcp_parameter* parameter, void* user);
     void (*initializeDoneCb)(void* user);
+    void (*responseDoneCb)(int16_t id, void* user);
 
     void* user;
 };
@@ -129,6 +146,10 @@ rcp_client* rcp_client_create(rcp_client_transporter* transporter)
             rcp_client_transporter_set_connected_cb(transporter, client, rcp_client_connected_cb);
             rcp_client_transporter_set_disconnected_cb(transporter, client, rcp_client_disconnected_cb);
         }
+
+#ifdef RCP_USE_ARENA
+        client->arena = rcp_arena_create(RCP_ARENA_BLOCK_SIZE);
+#endif
     }
     else
     {
@@ -143,6 +164,11 @@ void rcp_client_free(rcp_client* client)
     if (client)
     {
         rcp_manager_free(client->manager);
+        rcp_packet_free(client->receive_packet);
+
+#ifdef RCP_USE_ARENA
+        rcp_arena_free(client->arena);
+#endif
 
         if (client->applicationId)
         {
@@ -245,6 +271,65 @@ void rcp_client_manager_data_cb_all(void* c, const char* data, size_t size)
 
 
 
+// send command with optional id
+static void _send_command(rcp_client* client, rcp_packet_command command, int16_t id)
+{
+    if (client->transporter == NULL) return;
+
+    if (id == 0)
+    {
+        char data[2];
+        data[0] = command;
+        data[1] = RCP_TERMINATOR;
+
+        client->transporter->send(client->transporter, data, 2);
+        return;
+    }
+
+    rcp_packet* packet = rcp_packet_create(command);
+    if (packet == NULL) return;
+
+    rcp_packet_set_iddata(packet, id);
+
+    char* data_out = NULL;
+    size_t data_out_size = rcp_packet_write(packet, &data_out, false);
+
+    if (data_out_size > 0 &&
+            data_out != NULL)
+    {
+        client->transporter->send(client->transporter, data_out, data_out_size);
+
+        RCP_CLIENT_MALLOC_DEBUG("+++ data out: %p\n", data_out);
+        RCP_FREE(data_out);
+    }
+
+    rcp_packet_free(packet);
+}
+
+// extension listed in build metadata of version: 0.1.0+ext1.ext2
+static bool _has_extension(const char* version, const char* extension)
+{
+    const char* metadata = strchr(version, '+');
+    if (metadata == NULL) return false;
+
+    size_t length = strlen(extension);
+    const char* token = metadata + 1;
+
+    while (token != NULL)
+    {
+        if (strncmp(token, extension, length) == 0 &&
+                (token[length] == 0 || token[length] == '.'))
+        {
+            return true;
+        }
+
+        token = strchr(token, '.');
+        if (token != NULL) token++;
+    }
+
+    return false;
+}
+
 static inline void _do_command_info(rcp_client* client, rcp_packet* packet)
 {
     // NOTE: packet owns infodata
@@ -284,18 +369,12 @@ static inline void _do_command_info(rcp_client* client, rcp_packet* packet)
             }
         }
 
+        client->serverSubscribe = version != NULL && _has_extension(version, RCP_EXTENSION_SUBSCRIBE);
+
         if (is_compatible)
         {
             // send init if server is compatible
-            if (client->transporter)
-            {
-                // send initialize
-                char data[2];
-                data[0] = COMMAND_INITIALIZE;
-                data[1] = RCP_TERMINATOR;
-
-                client->transporter->send(client->transporter, data, 2);
-            }
+            _send_command(client, client->discover ? COMMAND_DISCOVER : COMMAND_INITIALIZE, 0);
 
             // accept data
             client->acceptParameter = true;
@@ -349,11 +428,58 @@ void rcp_client_receive_cb(rcp_client* client, const char* data, size_t size)
     if (client == NULL) return;    
 
     // parse data
-    rcp_packet* packet = NULL;
+    // reuse receive packet - nested calls create their own
+    rcp_packet* packet = client->receive_packet;
+    client->receive_packet = NULL;
+
+#ifdef RCP_USE_ARENA
+    // parse into arena - nested calls parse without arena
+    rcp_arena* arena = client->arena;
+    client->arena = NULL;
+#endif
 
     while (data != NULL
            && size > 0)
     {
+        if (client->acceptParameter)
+        {
+            // fast path: apply value updates in place
+            const char* applied_data = rcp_manager_apply_value_update(client->manager, data, &size);
+            if (applied_data != NULL)
+            {
+                data = applied_data;
+                continue;
+            }
+        }
+
+        if (!client->acceptParameter
+                && (data[0] == COMMAND_UPDATE || data[0] == COMMAND_UPDATEVALUE))
+        {
+            // skip parameters without parsing them
+            rcp_scan_info info;
+            if (rcp_scanner_scan_packet(data, size, &info))
+            {
+                RCP_CLIENT_DEBUG("client does not accept parameters! - %d\n", info.id);
+
+                data += info.size;
+                size -= info.size;
+                continue;
+            }
+        }
+
+        // parameters which get added to the cache need to own their data
+        bool keep_parameter = client->acceptParameter
+                && (data[0] == COMMAND_UPDATE || data[0] == COMMAND_UPDATEVALUE)
+                && rcp_manager_get_parameter(client->manager, rcp_packet_peek_parameter_id(data, size)) == NULL;
+
+#ifdef RCP_USE_ARENA
+        // parameters which get added to the cache must not live in the arena
+        rcp_arena* packet_arena = (packet != NULL && !keep_parameter) ? arena : NULL;
+        rcp_packet_set_arena(packet, packet_arena);
+#endif
+
+        // strings of parameters we merge can reference data
+        rcp_packet_set_borrow_strings(packet, !keep_parameter);
         data = rcp_packet_parse((char*)data, size, &packet, &size);
 
         if (data && packet)
@@ -366,18 +492,34 @@ void rcp_client_receive_cb(rcp_client* client, const char* data, size_t size)
                 break;
 
             case COMMAND_INITIALIZE:
-                // init marks the end of init
-                if (client->initializeDoneCb != NULL)
+            {
+                // init marks the end of init, discover or init with id
+                int16_t id = rcp_packet_get_iddata(packet);
+                if (id == 0)
+                {
+                    if (client->initializeDoneCb != NULL)
+                    {
+                        client->initializeDoneCb(client->user);
+                    }
+                }
+                else if (client->responseDoneCb != NULL)
                 {
-                    client->initializeDoneCb(client->user);
+                    client->responseDoneCb(id, client->user);
                 }
                 break;
+            }
 
             case COMMAND_DISCOVER:
                 // no discovery on client
                 RCP_CLIENT_DEBUG("ignore command 'discover' on client!\n");
                break;
 
+            case COMMAND_SUBSCRIBE:
+            case COMMAND_UNSUBSCRIBE:
+                // no subscriptions on client
+                RCP_CLIENT_DEBUG("ignore subscription on client!\n");
+                break;
+
             case COMMAND_UPDATE:
             case COMMAND_UPDATEVALUE:
             {
@@ -493,9 +635,34 @@ void rcp_client_receive_cb(rcp_client* client, const char* data, size_t size)
                 break;
             }
 
-            //
+        }
+
+#ifdef RCP_USE_ARENA
+        if (packet_arena != NULL)
+        {
+            // release parsed parameter before its memory is reused
+            rcp_packet_reset(packet, COMMAND_INVALID);
+            rcp_packet_set_arena(packet, NULL);
+            rcp_arena_reset(packet_arena);
+        }
+#endif
+    }
+
+#ifdef RCP_USE_ARENA
+    client->arena = arena;
+#endif
+
+    if (packet != NULL)
+    {
+        if (client->receive_packet == NULL)
+        {
+            // keep it - release parsed data
+            rcp_packet_reset(packet, COMMAND_INVALID);
+            client->receive_packet = packet;
+        }
+        else
+        {
             rcp_packet_free(packet);
-            packet = NULL;
         }
     }
 }
@@ -517,6 +684,7 @@ void rcp_client_disconnected_cb(rcp_client* client)
     if (client)
     {
         client->acceptParameter = false;
+        client->serverSubscribe = false;
 
         // free all paramters
         rcp_manager_clear(client->manager);
@@ -539,6 +707,67 @@ void rcp_client_set_parameter_removed_cb(rcp_client* client, void (*cb)(rcp_para
     }
 }
 
+// discover the root group after connecting instead of initializing all parameters
+// use rcp_client_discover and rcp_client_initialize to load parameters
+void rcp_client_set_discover(rcp_client* client, bool discover)
+{
+    if (client)
+    {
+        client->discover = discover;
+    }
+}
+
+// request parameter and direct children of a group without values - id 0: root group
+void rcp_client_discover(rcp_client* client, int16_t id)
+{
+    if (client)
+    {
+        _send_command(client, COMMAND_DISCOVER, id);
+    }
+}
+
+// request parameter and direct children of a group - id 0: all parameters
+void rcp_client_initialize(rcp_client* client, int16_t id)
+{
+    if (client)
+    {
+        _send_command(client, COMMAND_INITIALIZE, id);
+    }
+}
+
+// only receive updates of parameter and its children - id 0: root group
+// without subscriptions updates of all parameters are received
+// the server answers with the current state of the parameter and its direct children
+// subscriptions are an rcp-c extension - returns false if the server did not announce it
+bool rcp_client_subscribe(rcp_client* client, int16_t id)
+{
+    if (client == NULL) return false;
+
+    if (!client->serverSubscribe)
+    {
+        RCP_CLIENT_DEBUG("server does not support subscriptions\n");
+        return false;
+    }
+
+    _send_command(client, COMMAND_SUBSCRIBE, id);
+    return true;
+}
+
+// id 0: remove all subscriptions
+bool rcp_client_unsubscribe(rcp_client* client, int16_t id)
+{
+    if (client == NULL) return false;
+
+    if (!client->serverSubscribe)
+    {
+        RCP_CLIENT_DEBUG("server does not support subscriptions\n");
+        return false;
+    }
+
+    _send_command(client, COMMAND_UNSUBSCRIBE, id);
+    return true;
+}
+
 void rcp_client_set_init_done_cb(rcp_client* client, void (*cb)(void* user))
 {
     if (client)
@@ -546,3 +775,13 @@ void rcp_client_set_init_done_cb(rcp_client* client, void (*cb)(void* user))
         client->initializeDoneCb = cb;
     }
 }
+
+// called when all parameters of rcp_client_discover or rcp_client_initialize
+// with an id were received - id 0 calls the init done callback
+void rcp_client_set_response_done_cb(rcp_client* client, void (*cb)(int16_t id, void* user))
+{
+    if (client)
+    {
+        client->responseDoneCb = cb;
+    }
+}
@@ -51,6 +51,16 @@ void rcp_client_set_id(rcp_client* client, const char* id); // copy id
 // user - used for callbacks
 void rcp_client_set_user(rcp_client* client, void* user);
 
+// lazy loading - see rcp_client_set_discover
+void rcp_client_set_discover(rcp_client* client, bool discover); // discover root group on connect
+void rcp_client_discover(rcp_client* client, int16_t id); // without values, 0: root group
+void rcp_client_initialize(rcp_client* client, int16_t id); // with values, 0: all parameters
+
+// subscriptions - without subscriptions updates of all parameters are received
+// rcp-c protocol extension - returns false if the server did not announce it in INFO
+bool rcp_client_subscribe(rcp_client* client, int16_t id); // updates of parameter and its children, 0: root group
+bool rcp_client_unsubscribe(rcp_client* client, int16_t id); // 0: all subscriptions
+
 void rcp_client_update(rcp_client* client);
 void rcp_client_log(rcp_client* client);
 
@@ -67,6 +77,7 @@ void rcp_client_disconnected_cb(rcp_client* client);
 void rcp_client_set_parameter_added_cb(rcp_client* client, void (*cb)(rcp_parameter* parameter, void* user));
 void rcp_client_set_parameter_removed_cb(rcp_client* client, void (*cb)(rcp_parameter* parameter, void* user));
 void rcp_client_set_init_done_cb(rcp_client* client, void (*cb)(void* user));
+void rcp_client_set_response_done_cb(rcp_client* client, void (*cb)(int16_t id, void* user)); // discover or initialize with id
 
 #ifdef __cplusplus
 } // extern "C"
@@ -24,6 +24,24 @@
 
 #include "rcp_endian.h"
 
+// simd path for bulk conversion - picked at compile time
+#if defined(__AVX2__)
+  #include <immintrin.h>
+  #define RCP_ENDIAN_AVX2
+  #define RCP_ENDIAN_SSSE3
+  #define RCP_ENDIAN_SSE2
+#elif defined(__SSSE3__)
+  #include <tmmintrin.h>
+  #define RCP_ENDIAN_SSSE3
+  #define RCP_ENDIAN_SSE2
+#elif defined(__SSE2__) || defined(_M_X64)
+  #include <emmintrin.h>
+  #define RCP_ENDIAN_SSE2
+#elif defined(__ARM_NEON)
+  #include <arm_neon.h>
+  #define RCP_ENDIAN_NEON
+#endif
+
 static __inline uint16_t
 __bswap16(uint16_t _x)
 {
@@ -84,3 +102,165 @@ uint64_t ntohll(uint64_t x)
 #endif
 }
 #endif
+
+
+/*
+ * bulk conversion
+ */
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  // data is in host order already
+  #define RCP_ENDIAN_HOST_BIG
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+  #define _rcp_bswap16(x) __builtin_bswap16(x)
+  #define _rcp_bswap32(x) __builtin_bswap32(x)
+  #define _rcp_bswap64(x) __builtin_bswap64(x)
+#else
+  #define _rcp_bswap16(x) __bswap16(x)
+  #define _rcp_bswap32(x) __bswap32(x)
+  #define _rcp_bswap64(x) __bswap64(x)
+#endif
+
+#if defined(RCP_ENDIAN_SSSE3)
+// byte order of one 128-bit lane per element width
+static const char _shuffle16[16] = { 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 };
+static const char _shuffle32[16] = { 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12 };
+static const char _shuffle64[16] = { 7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8 };
+#endif
+
+// swap bytes of all elements
+// returns number of bytes handled - the rest is done by the scalar loop
+static size_t _swap_simd(char* dst, const char* src, size_t bytes, size_t width)
+{
+    size_t offset = 0;
+
+#if defined(RCP_ENDIAN_SSSE3)
+    const char* shuffle = width == 2 ? _shuffle16 : (width == 4 ? _shuffle32 : _shuffle64);
+    __m128i mask = _mm_loadu_si128((const __m128i*)shuffle);
+
+  #if defined(RCP_ENDIAN_AVX2)
+    // shuffle works per 128-bit lane
+    __m256i mask256 = _mm256_broadcastsi128_si256(mask);
+    for (; offset + 32 <= bytes; offset += 32)
+    {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(src + offset));
+        _mm256_storeu_si256((__m256i*)(dst + offset), _mm256_shuffle_epi8(v, mask256));
+    }
+  #endif
+
+    for (; offset + 16 <= bytes; offset += 16)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i*)(src + offset));
+        _mm_storeu_si128((__m128i*)(dst + offset), _mm_shuffle_epi8(v, mask));
+    }
+#elif defined(RCP_ENDIAN_SSE2)
+    for (; offset + 16 <= bytes; offset += 16)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i*)(src + offset));
+
+        // reverse 16-bit words within elements
+        if (width == 4)
+        {
+            v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+            v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+        }
+        else if (width == 8)
+        {
+            v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+            v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+        }
+
+        // swap bytes within 16-bit words
+        v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+        _mm_storeu_si128((__m128i*)(dst + offset), v);
+    }
+#elif defined(RCP_ENDIAN_NEON)
+    for (; offset + 16 <= bytes; offset += 16)
+    {
+        uint8x16_t v = vld1q_u8((const uint8_t*)(src + offset));
+
+        if (width == 2) v = vrev16q_u8(v);
+        else if (width == 4) v = vrev32q_u8(v);
+        else v = vrev64q_u8(v);
+
+        vst1q_u8((uint8_t*)(dst + offset), v);
+    }
+#else
+    (void)dst;
+    (void)src;
+    (void)bytes;
+    (void)width;
+#endif
+
+    return offset;
+}
+
+static void _swap_array(char* dst, const char* src, size_t count, size_t width)
+{
+    if (dst == NULL) return;
+    if (src == NULL) return;
+
+#if defined(RCP_ENDIAN_HOST_BIG)
+    memcpy(dst, src, count * width);
+#else
+    size_t bytes = count * width;
+    size_t offset = _swap_simd(dst, src, bytes, width);
+
+    for (; offset < bytes; offset += width)
+    {
+        if (width == 2)
+        {
+            uint16_t v;
+            memcpy(&v, src + offset, 2);
+            v = _rcp_bswap16(v);
+            memcpy(dst + offset, &v, 2);
+        }
+        else if (width == 4)
+        {
+            uint32_t v;
+            memcpy(&v, src + offset, 4);
+            v = _rcp_bswap32(v);
+            memcpy(dst + offset, &v, 4);
+        }
+        else
+        {
+            uint64_t v;
+            memcpy(&v, src + offset, 8);
+            v = _rcp_bswap64(v);
+            memcpy(dst + offset, &v, 8);
+        }
+    }
+#endif
+}
+
+void rcp_load_be_u16_array(void* dst, const char* src, size_t count)
+{
+    _swap_array((char*)dst, src, count, 2);
+}
+
+void rcp_load_be_u32_array(void* dst, const char* src, size_t count)
+{
+    _swap_array((char*)dst, src, count, 4);
+}
+
+void rcp_load_be_u64_array(void* dst, const char* src, size_t count)
+{
+    _swap_array((char*)dst, src, count, 8);
+}
+
+void rcp_store_be_u16_array(char* dst, const void* src, size_t count)
+{
+    _swap_array(dst, (const char*)src, count, 2);
+}
+
+void rcp_store_be_u32_array(char* dst, const void* src, size_t count)
+{
+    _swap_array(dst, (const char*)src, count, 4);
+}
+
+void rcp_store_be_u64_array(char* dst, const void* src, size_t count)
+{
+    _swap_array(dst, (const char*)src, count, 8);
+}
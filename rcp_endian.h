@@ -80,6 +80,20 @@ uint64_t ntohll(uint64_t x);
     do { uint64_t val = _rcp_be64(num); memcpy(to, &val, 8); } while(0)
 
 
+// bulk conversion of count elements between big-endian data and host order
+// host arrays are accessed bytewise: float and double arrays can be passed
+// to the 32 and 64 bit variants
+// data and host arrays may be unaligned but must not overlap
+// for a few elements use the _rcp_load and _rcp_store macros - no dispatch
+void rcp_load_be_u16_array(void* dst, const char* src, size_t count);
+void rcp_load_be_u32_array(void* dst, const char* src, size_t count);
+void rcp_load_be_u64_array(void* dst, const char* src, size_t count);
+
+void rcp_store_be_u16_array(char* dst, const void* src, size_t count);
+void rcp_store_be_u32_array(char* dst, const void* src, size_t count);
+void rcp_store_be_u64_array(char* dst, const void* src, size_t count);
+
+
 #ifdef __cplusplus
 } // extern "C"
 #endif
@@ -0,0 +1,171 @@
+/*
+********************************************************************
+* RabbitControl - a protocol for remote control.
+* https://rabbitcontrol.cc
+*
+* Copyright (C) 2024, Ingo Randolf
+*
+* This file is part of RabbitControl for C (rcp-c).
+*
+* rcp-c is free software: you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License,
+* or (at your option) any later version.
+*
+* rcp-c is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+* See the GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with rcp-c. If not, see <https://www.gnu.org/licenses/>.
+*********************************************************************
+*/
+
+#include "rcp_idmap.h"
+
+#include "rcp_memory.h"
+#include "rcp_logging.h"
+
+#if defined(RCP_IDMAP_DEBUG_LOG) || defined(RCP_ALL_DEBUG)
+#define RCP_IDMAP_DEBUG(...) RCP_DEBUG(__VA_ARGS__)
+#else
+#define RCP_IDMAP_DEBUG(...)
+#endif
+
+#if defined(RCP_IDMAP_MALLOC_DEBUG_LOG) || defined(RCP_ALL_DEBUG)
+#define RCP_IDMAP_MALLOC_DEBUG(...) RCP_DEBUG(__VA_ARGS__)
+#else
+#define RCP_IDMAP_MALLOC_DEBUG(...)
+#endif
+
+#define RCP_IDMAP_PAGE_SIZE (1 << RCP_IDMAP_PAGE_BITS)
+#define RCP_IDMAP_PAGE_COUNT (1 << (16 - RCP_IDMAP_PAGE_BITS))
+#define RCP_IDMAP_PAGE_MASK (RCP_IDMAP_PAGE_SIZE - 1)
+
+typedef struct rcp_idmap_page
+{
+    uint32_t count;
+    void* values[RCP_IDMAP_PAGE_SIZE];
+
+} rcp_idmap_page;
+
+struct rcp_idmap
+{
+    rcp_idmap_page* pages[RCP_IDMAP_PAGE_COUNT];
+};
+
+
+rcp_idmap* rcp_idmap_create()
+{
+    rcp_idmap* map = (rcp_idmap*)RCP_CALLOC(1, sizeof(rcp_idmap));
+
+    if (map != NULL)
+    {
+        RCP_IDMAP_MALLOC_DEBUG("*** idmap: %p\n", map);
+    }
+    else
+    {
+        RCP_ERROR("could not malloc idmap\n");
+    }
+
+    return map;
+}
+
+void rcp_idmap_free(rcp_idmap* map)
+{
+    if (map != NULL)
+    {
+        rcp_idmap_clear(map);
+
+        RCP_IDMAP_MALLOC_DEBUG("+++ idmap: %p\n", map);
+        RCP_FREE(map);
+    }
+}
+
+bool rcp_idmap_put(rcp_idmap* map, int16_t id, void* value)
+{
+    if (map == NULL) return false;
+    if (value == NULL) return false;
+
+    uint16_t key = (uint16_t)id;
+    rcp_idmap_page** page = &map->pages[key >> RCP_IDMAP_PAGE_BITS];
+
+    if (*page == NULL)
+    {
+        *page = (rcp_idmap_page*)RCP_CALLOC(1, sizeof(rcp_idmap_page));
+        if (*page == NULL)
+        {
+            RCP_ERROR("could not malloc idmap page\n");
+            return false;
+        }
+
+        RCP_IDMAP_MALLOC_DEBUG("*** idmap page: %p\n", *page);
+    }
+
+    void** slot = &(*page)->values[key & RCP_IDMAP_PAGE_MASK];
+    if (*slot == NULL)
+    {
+        (*page)->count++;
+    }
+
+    *slot = value;
+
+    return true;
+}
+
+void* rcp_idmap_get(rcp_idmap* map, int16_t id)
+{
+    if (map == NULL) return NULL;
+
+    uint16_t key = (uint16_t)id;
+    rcp_idmap_page* page = map->pages[key >> RCP_IDMAP_PAGE_BITS];
+
+    if (page == NULL) return NULL;
+
+    return page->values[key & RCP_IDMAP_PAGE_MASK];
+}
+
+void* rcp_idmap_remove(rcp_idmap* map, int16_t id)
+{
+    if (map == NULL) return NULL;
+
+    uint16_t key = (uint16_t)id;
+    rcp_idmap_page** page = &map->pages[key >> RCP_IDMAP_PAGE_BITS];
+
+    if (*page == NULL) return NULL;
+
+    void** slot = &(*page)->values[key & RCP_IDMAP_PAGE_MASK];
+    void* value = *slot;
+
+    if (value != NULL)
+    {
+        *slot = NULL;
+        (*page)->count--;
+
+        if ((*page)->count == 0)
+        {
+            // page got empty
+            RCP_IDMAP_MALLOC_DEBUG("+++ idmap page: %p\n", *page);
+            RCP_FREE(*page);
+            *page = NULL;
+        }
+    }
+
+    return value;
+}
+
+void rcp_idmap_clear(rcp_idmap* map)
+{
+    if (map == NULL) return;
+
+    for (int i = 0; i < RCP_IDMAP_PAGE_COUNT; i++)
+    {
+        if (map->pages[i] != NULL)
+        {
+            RCP_IDMAP_MALLOC_DEBUG("+++ idmap page: %p\n", map->pages[i]);
+            RCP_FREE(map->pages[i]);
+            map->pages[i] = NULL;
+        }
+    }
+}
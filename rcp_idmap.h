@@ -0,0 +1,60 @@
+/*
+********************************************************************
+* RabbitControl - a protocol for remote control.
+* https://rabbitcontrol.cc
+*
+* Copyright (C) 2024, Ingo Randolf
+*
+* This file is part of RabbitControl for C (rcp-c).
+*
+* rcp-c is free software: you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License,
+* or (at your option) any later version.
+*
+* rcp-c is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+* See the GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with rcp-c. If not, see <https://www.gnu.org/licenses/>.
+*********************************************************************
+*/
+
+#ifndef RCP_IDMAP_H
+#define RCP_IDMAP_H
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+//#define RCP_IDMAP_DEBUG_LOG
+//#define RCP_IDMAP_MALLOC_DEBUG_LOG
+
+// two-level table over the 16bit id space
+// pages are allocated on first use and freed when they get empty
+#ifndef RCP_IDMAP_PAGE_BITS
+#define RCP_IDMAP_PAGE_BITS 8
+#endif
+
+typedef struct rcp_idmap rcp_idmap;
+
+// create / free
+rcp_idmap* rcp_idmap_create();
+void rcp_idmap_free(rcp_idmap* map);
+
+// access
+bool rcp_idmap_put(rcp_idmap* map, int16_t id, void* value); // no transfer
+void* rcp_idmap_get(rcp_idmap* map, int16_t id);
+void* rcp_idmap_remove(rcp_idmap* map, int16_t id);
+void rcp_idmap_clear(rcp_idmap* map);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // RCP_IDMAP_H
@@ -55,6 +55,9 @@ struct rcp_language_str
     // string type: string-tiny, string-short, string-long
     rcp_string_types type;
 
+    // str references parsed data - not zero-terminated
+    bool borrowed;
+
     // the 3-character language code (not 0-terminated)
     char code[RCP_LANGUAGE_CODE_SIZE];
 };
@@ -78,6 +81,21 @@ rcp_language_str* rcp_langstr_create(const char* code)
 }
 
 
+static void _copy_string(rcp_language_str* ls, const char* str, size_t str_len, rcp_string_types type);
+
+// length of string - borrowed strings are not zero-terminated
+static size_t _string_length(rcp_language_str* ls)
+{
+    if (ls->str == NULL) return 0;
+
+    if (ls->borrowed)
+    {
+        return ls->length - ls->type - RCP_LANGUAGE_CODE_SIZE;
+    }
+
+    return strlen(ls->str);
+}
+
 rcp_language_str* rcp_langstr_copy(rcp_language_str* ls)
 {
     // recreate language string chain
@@ -95,7 +113,7 @@ rcp_language_str* rcp_langstr_copy(rcp_language_str* ls)
             return NULL;
         }
 
-        rcp_langstr_copy_string(new_lng_str, src_lng_str->str, src_lng_str->type);
+        _copy_string(new_lng_str, src_lng_str->str, _string_length(src_lng_str), src_lng_str->type);
         new_lng_str->next = dst_lng_str;
         dst_lng_str = new_lng_str;
 
@@ -117,7 +135,8 @@ void rcp_langstr_free_chain(rcp_language_str* ls)
     {
         next = ls->next;
 
-        if (ls->str != NULL)
+        if (ls->str != NULL
+                && !ls->borrowed)
         {
             RCP_LANGUAGE_STRING_MALLOC_DEBUG("+++ langstr str: %p\n", ls->str);
             RCP_FREE(ls->str);
@@ -135,7 +154,7 @@ void rcp_langstr_log_chain(rcp_language_str* ls)
 {
     while (ls)
     {
-        RCP_INFO_ONLY("str [%s]: %s\n", ls->code, ls->str);
+        RCP_INFO_ONLY("str [%.3s]: %.*s\n", ls->code, (int)_string_length(ls), ls->str);
         ls = ls->next;
     }
 }
@@ -178,7 +197,7 @@ bool rcp_langstr_is_code(rcp_language_str* ls, const char* code)
 {
     if (ls == NULL) return false;
 
-    return strcmp(ls->code, code) == 0;
+    return strncmp(ls->code, code, RCP_LANGUAGE_CODE_SIZE) == 0;
 }
 
 const char* rcp_langstr_get_code(rcp_language_str* ls)
@@ -195,11 +214,15 @@ static void _langstr_free_str(rcp_language_str* ls)
     if (ls != NULL &&
             ls->str != NULL)
     {
-        RCP_LANGUAGE_STRING_MALLOC_DEBUG("+++ string: %p\n", ls->str);
-        RCP_FREE((void*)ls->str);
+        if (!ls->borrowed)
+        {
+            RCP_LANGUAGE_STRING_MALLOC_DEBUG("+++ string: %p\n", ls->str);
+            RCP_FREE((void*)ls->str);
+        }
 
         ls->str = NULL;
         ls->length = 0;
+        ls->borrowed = false;
     }
 }
 
@@ -225,13 +248,19 @@ void rcp_langstr_set_string(rcp_language_str* ls, const char* str, size_t str_le
  *  langstr "owns" the data and attempts to free it
  */
 void rcp_langstr_copy_string(rcp_language_str* ls, const char* str, rcp_string_types type)
+{
+    if (str == NULL) return;
+
+    _copy_string(ls, str, strlen(str), type);
+}
+
+static void _copy_string(rcp_language_str* ls, const char* str, size_t str_len, rcp_string_types type)
 {
     if (ls == NULL) return;
 
     _langstr_free_str(ls);
 
     // malloc
-    size_t str_len = strlen(str);
     if (str_len > 0)
     {
         ls->str = (char*)RCP_CALLOC(1, str_len + 1);
@@ -240,24 +269,71 @@ void rcp_langstr_copy_string(rcp_language_str* ls, const char* str, rcp_string_t
         {
             RCP_LANGUAGE_STRING_MALLOC_DEBUG("*** string data: %p\n", ls->str);
 
-            strncpy(ls->str, str, str_len);
-
-            ls->length = str_len + type + RCP_LANGUAGE_CODE_SIZE;
-            ls->type = type;
-
-//            RCP_LANGUAGE_STRING_DEBUG("string data: %s\n", ls->str);
-//            RCP_LANGUAGE_STRING_DEBUG("lng string length: %d\n", ls->length);
+            memcpy(ls->str, str, str_len);
         }
         else
         {
             RCP_ERROR("could not allocate for string\n");
+            return;
         }
     }
+
+    ls->length = str_len + type + RCP_LANGUAGE_CODE_SIZE;
+    ls->type = type;
 }
 
+/* rcp_langstr_set_view
+ *  borrow str if borrow is set, copy it otherwise
+ *  str is not zero-terminated - a borrowed str needs to outlive ls
+ */
+void rcp_langstr_set_view(rcp_language_str* ls, const char* str, size_t str_len, rcp_string_types type, bool borrow)
+{
+    if (ls == NULL) return;
+
+    if (!borrow)
+    {
+        _copy_string(ls, str, str_len, type);
+        return;
+    }
+
+    _langstr_free_str(ls);
+
+    ls->str = (char*)str;
+    ls->length = str_len + type + RCP_LANGUAGE_CODE_SIZE;
+    ls->type = type;
+    ls->borrowed = true;
+}
+
+// copy borrowed strings of chain into owned memory
+void rcp_langstr_own_chain(rcp_language_str* ls)
+{
+    while (ls)
+    {
+        if (ls->borrowed)
+        {
+            const char* str = ls->str;
+            _copy_string(ls, str, _string_length(ls), ls->type);
+        }
+
+        ls = ls->next;
+    }
+}
+
+// zero-terminated string - NULL for borrowed strings
 const char* rcp_langstr_get_string(rcp_language_str* ls)
 {
     if (ls == NULL) return NULL;
+    if (ls->borrowed) return NULL;
+    return ls->str;
+}
+
+// string and its length - not necessarily zero-terminated
+const char* rcp_langstr_get_string_view(rcp_language_str* ls, size_t* length)
+{
+    if (length != NULL) *length = 0;
+    if (ls == NULL) return NULL;
+
+    if (length != NULL) *length = _string_length(ls);
     return ls->str;
 }
 
@@ -269,7 +345,11 @@ size_t rcp_langstr_write(rcp_language_str* lng_str, char* data, size_t size)
 
     while (lng_str)
     {
-        // TODO: check size first
+        if (size - written <= RCP_LANGUAGE_CODE_SIZE)
+        {
+            RCP_LANGUAGE_STRING_DEBUG("offset >= data_size! 0\n");
+            return 0;
+        }
 
         // write language code
         memcpy(data, rcp_langstr_get_code(lng_str), RCP_LANGUAGE_CODE_SIZE);
@@ -283,17 +363,29 @@ size_t rcp_langstr_write(rcp_language_str* lng_str, char* data, size_t size)
 
         data += RCP_LANGUAGE_CODE_SIZE;
 
-        switch (lng_str->type)
+        if (lng_str->borrowed)
         {
-        case TINY_STRING:
-            written_len = rcp_write_tiny_string(data, (size - written), lng_str->str);
-            break;
-        case SHORT_STRING:
-            written_len = rcp_write_short_string(data, (size - written), lng_str->str);
-            break;
-        case LONG_STRING:
-            written_len = rcp_write_long_string(data, (size - written), lng_str->str);
-            break;
+            written_len = rcp_write_string(data, (size - written), lng_str->str, _string_length(lng_str), lng_str->type);
+        }
+        else
+        {
+            switch (lng_str->type)
+            {
+            case TINY_STRING:
+                written_len = rcp_write_tiny_string(data, (size - written), lng_str->str);
+                break;
+            case SHORT_STRING:
+                written_len = rcp_write_short_string(data, (size - written), lng_str->str);
+                break;
+            case LONG_STRING:
+                written_len = rcp_write_long_string(data, (size - written), lng_str->str);
+                break;
+            }
+        }
+
+        if (written_len == 0)
+        {
+            return 0;
         }
 
         written += written_len;
@@ -58,8 +58,11 @@ const char* rcp_langstr_get_code(rcp_language_str* ls);
 // setter / getter
 void rcp_langstr_set_string(rcp_language_str* ls, const char* str, size_t str_len, rcp_string_types type); // full transfer
 void rcp_langstr_copy_string(rcp_language_str* ls, const char* str, rcp_string_types type);
+void rcp_langstr_own_chain(rcp_language_str* ls);
+void rcp_langstr_set_view(rcp_language_str* ls, const char* str, size_t str_len, rcp_string_types type, bool borrow); // no transfer if borrow
 
-const char* rcp_langstr_get_string(rcp_language_str* ls);
+const char* rcp_langstr_get_string(rcp_language_str* ls); // NULL if borrowed
+const char* rcp_langstr_get_string_view(rcp_language_str* ls, size_t* length); // not zero-terminated if borrowed
 
 // size and write
 size_t rcp_langstr_get_size(rcp_language_str* ls);
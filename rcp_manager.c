@@ -24,12 +24,22 @@
 
 #include "rcp_manager.h"
 
+#include <stddef.h>
 #include <string.h>
+#include <time.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
 
 #include "rcp_memory.h"
 #include "rcp_logging.h"
 #include "rcp_packet.h"
+#include "rcp_parser.h"
 #include "rcp_parameter.h"
+#include "rcp_typedefinition.h"
+#include "rcp_idmap.h"
+#include "rcp_pool.h"
 
 
 #if defined(RCP_MANAGER_DEBUG_LOG) || defined(RCP_ALL_DEBUG)
@@ -44,12 +54,109 @@
 #define RCP_MANAGER_MALLOC_DEBUG(...)
 #endif
 
+// one bit per id (uint16 view), set for ids in use or pending removal
+#define RCP_MANAGER_ID_WORDS (65536 / 32)
+
+// entries in first slab of entry pool
+#define RCP_MANAGER_ENTRY_SLAB_COUNT 32
+
+// initial bucket count of label index
+#define RCP_MANAGER_INDEX_SIZE 64
+
+// path separator for rcp_manager_find_path
+#define RCP_MANAGER_PATH_SEPARATOR '/'
+
+typedef struct rcp_manager_entry rcp_manager_entry;
+typedef struct rcp_manager_index_link rcp_manager_index_link;
+typedef struct rcp_manager_index rcp_manager_index;
+
+// link of entry in a label index
+struct rcp_manager_index_link
+{
+    rcp_manager_entry* next;
+    uint32_t hash;
+    bool linked;
+};
+
+// hashed labels - buckets created on first use
+struct rcp_manager_index
+{
+    rcp_manager_entry** buckets;
+    uint32_t size;
+    uint32_t count;
+    size_t link_offset; // of link in rcp_manager_entry
+};
+
+// parameter entry of manager
+struct rcp_manager_entry
+{
+    // entry in parameter list - must be first
+    rcp_parameter_list list;
+
+    rcp_manager_index_link label_link; // (parent-id, label)
+    rcp_manager_index_link group_link; // label of groups
+
+    // serialized parameter in snapshot
+    size_t snapshot_offset;
+    size_t snapshot_size;
+    bool snapshot_stale;
+    rcp_manager_entry* snapshot_next; // list of changed entries
+};
+
 struct rcp_manager
 {
     rcp_parameter_list* parameters;
-    rcp_parameter_list* dirty_parameters;
+    rcp_parameter_list* dirty_parameters; // intrusive queue, see rcp_parameter_get_dirty_entry
+    rcp_parameter_list* dirty_tail;
+    rcp_parameter_list* throttled_parameters; // rate limited - ordered by next send time
+    rcp_parameter_list* throttled_tail;
+    size_t dirty_count; // dirty and throttled
+    size_t removed_count;
     rcp_parameter_list* removed_parameters; // only used on servers
 
+    // id -> entry
+    rcp_idmap* parameter_map;
+
+    // memory of entries
+    rcp_pool* entry_pool;
+
+    // (parent-id, label) -> entry
+    rcp_manager_index label_index;
+    // label -> group entry - for finding groups on any level
+    rcp_manager_index group_index;
+
+    // id allocator - created on first use
+    uint32_t* id_bits;
+    uint32_t id_search_word; // no free id below this word
+
+    // reused for serializing packets
+    char* write_buffer;
+    size_t write_buffer_size;
+
+    // batching of packets - 0: one packet per frame
+    size_t max_frame_size;
+    size_t init_frame_size; // initial state and responses to one client
+    size_t frame_size; // bytes pending in write buffer
+
+    // pending frame goes to one client only - see rcp_manager_send_parameter
+    bool frame_to_one;
+    void* frame_client;
+
+    // reused for sending - NULL while in use
+    rcp_packet* send_packet;
+
+    // full state for initializing clients - see rcp_manager_get_snapshot
+    char* snapshot;
+    size_t snapshot_size;
+    size_t snapshot_buffer_size;
+    char* snapshot_back; // rebuild buffer
+    size_t snapshot_back_size;
+    rcp_manager_entry* snapshot_changed; // serialized again on next use
+    size_t* snapshot_ends; // end of each packet - for splitting into frames
+    size_t snapshot_ends_count;
+    size_t snapshot_ends_size;
+    bool snapshot_relayout; // parameter added, removed or moved
+
     uint16_t parameter_count;
 
     void (*sendDataCbOne)(void* user, const char* data, size_t size, void* client);
@@ -58,9 +165,43 @@ struct rcp_manager
     void (*parameterAddedCb)(rcp_parameter* parameter, void* user);
     void (*parameterRemovedCb)(rcp_parameter* parameter, void* user);
 
+    // monotonic time in nanoseconds
+    uint64_t (*clockCb)(void* user);
+
     void* user;
 };
 
+// label index memory
+
+static inline rcp_manager_index_link* _index_get_link(rcp_manager_index* index, rcp_manager_entry* entry)
+{
+    return (rcp_manager_index_link*)((char*)entry + index->link_offset);
+}
+
+static void _index_free(rcp_manager_index* index)
+{
+    if (index->buckets != NULL)
+    {
+        RCP_MANAGER_MALLOC_DEBUG("+++ label index: %p\n", index->buckets);
+        RCP_FREE(index->buckets);
+        index->buckets = NULL;
+    }
+
+    index->size = 0;
+    index->count = 0;
+}
+
+// entries are released - links are not touched
+static void _index_clear(rcp_manager_index* index)
+{
+    if (index->buckets != NULL)
+    {
+        memset(index->buckets, 0, index->size * sizeof(rcp_manager_entry*));
+    }
+
+    index->count = 0;
+}
+
 rcp_manager* rcp_manager_create(void* user)
 {
     rcp_manager* manager = RCP_CALLOC(1, sizeof(rcp_manager));
@@ -76,6 +217,23 @@ rcp_manager* rcp_manager_create(void* user)
             RCP_MANAGER_DEBUG("!! manager without user");
         }
 
+        manager->label_index.link_offset = offsetof(rcp_manager_entry, label_link);
+        manager->group_index.link_offset = offsetof(rcp_manager_entry, group_link);
+
+        manager->parameter_map = rcp_idmap_create();
+        manager->entry_pool = rcp_pool_create(sizeof(rcp_manager_entry), RCP_MANAGER_ENTRY_SLAB_COUNT);
+        if (manager->parameter_map == NULL ||
+                manager->entry_pool == NULL)
+        {
+            RCP_ERROR("could not create parameter map\n");
+
+            rcp_idmap_free(manager->parameter_map);
+            rcp_pool_free(manager->entry_pool);
+
+            RCP_MANAGER_MALLOC_DEBUG("+++ manager: %p\n", manager);
+            RCP_FREE(manager);
+            return NULL;
+        }
     }
     else
     {
@@ -90,30 +248,124 @@ void rcp_manager_free(rcp_manager* manager)
     if (manager)
     {
         rcp_manager_clear(manager);
+        rcp_idmap_free(manager->parameter_map);
+        rcp_pool_free(manager->entry_pool);
+
+        _index_free(&manager->label_index);
+        _index_free(&manager->group_index);
+
+        if (manager->id_bits != NULL)
+        {
+            RCP_MANAGER_MALLOC_DEBUG("+++ id bits: %p\n", manager->id_bits);
+            RCP_FREE(manager->id_bits);
+        }
+
+        if (manager->write_buffer != NULL)
+        {
+            RCP_MANAGER_MALLOC_DEBUG("+++ write buffer: %p\n", manager->write_buffer);
+            RCP_FREE(manager->write_buffer);
+        }
+
+        rcp_packet_free(manager->send_packet);
+
+        if (manager->snapshot != NULL)
+        {
+            RCP_MANAGER_MALLOC_DEBUG("+++ snapshot: %p\n", manager->snapshot);
+            RCP_FREE(manager->snapshot);
+        }
+
+        if (manager->snapshot_back != NULL)
+        {
+            RCP_MANAGER_MALLOC_DEBUG("+++ snapshot: %p\n", manager->snapshot_back);
+            RCP_FREE(manager->snapshot_back);
+        }
+
+        if (manager->snapshot_ends != NULL)
+        {
+            RCP_MANAGER_MALLOC_DEBUG("+++ snapshot ends: %p\n", manager->snapshot_ends);
+            RCP_FREE(manager->snapshot_ends);
+        }
 
         RCP_MANAGER_MALLOC_DEBUG("+++ manager: %p\n", manager);
         RCP_FREE(manager);
     }
 }
 
+static void _mark_id(rcp_manager* manager, int16_t id)
+{
+    if (manager->id_bits == NULL) return;
+
+    uint16_t key = (uint16_t)id;
+    manager->id_bits[key >> 5] |= (uint32_t)1 << (key & 31);
+}
+
+static void _release_id(rcp_manager* manager, int16_t id)
+{
+    if (manager->id_bits == NULL) return;
+
+    // id might have been reused while pending removal
+    if (rcp_idmap_get(manager->parameter_map, id) != NULL) return;
+
+    uint16_t key = (uint16_t)id;
+    manager->id_bits[key >> 5] &= ~((uint32_t)1 << (key & 31));
+
+    if ((uint32_t)(key >> 5) < manager->id_search_word)
+    {
+        manager->id_search_word = key >> 5;
+    }
+}
+
+static int _first_zero_bit(uint32_t word)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctz(~word);
+#else
+    int i = 0;
+    while (word & 1)
+    {
+        word >>= 1;
+        i++;
+    }
+    return i;
+#endif
+}
+
 void rcp_manager_clear(rcp_manager* manager)
 {
     if (manager)
     {
         //------------------
-        // remove dirty list
+        // clear dirty queue
         rcp_parameter_list* pe = manager->dirty_parameters;
         rcp_parameter_list* next;
         while (pe)
         {
             next = pe->next;
 
-            RCP_MANAGER_MALLOC_DEBUG("+++ dirty parameter list entry: %p\n", pe);
-            RCP_FREE(pe);
+            pe->next = NULL;
+            pe->prev = NULL;
+            rcp_parameter_set_queued(pe->parameter, false);
 
             pe = next;
         }
         manager->dirty_parameters = NULL;
+        manager->dirty_tail = NULL;
+
+        pe = manager->throttled_parameters;
+        while (pe)
+        {
+            next = pe->next;
+
+            pe->next = NULL;
+            pe->prev = NULL;
+            rcp_parameter_set_queued(pe->parameter, false);
+            rcp_parameter_set_throttled(pe->parameter, false);
+
+            pe = next;
+        }
+        manager->throttled_parameters = NULL;
+        manager->throttled_tail = NULL;
+        manager->dirty_count = 0;
 
 
         //--------------------
@@ -124,12 +376,13 @@ void rcp_manager_clear(rcp_manager* manager)
             next = pe->next;
 
             rcp_parameter_free(pe->parameter);
-            RCP_MANAGER_MALLOC_DEBUG("+++ removed parameter list entry: %p\n", pe);
-            RCP_FREE(pe);
+            RCP_MANAGER_MALLOC_DEBUG("+++ removed manager entry: %p\n", pe);
+            rcp_pool_release(manager->entry_pool, pe);
 
             pe = next;
         }
         manager->removed_parameters = NULL;
+        manager->removed_count = 0;
 
 
         //--------------------
@@ -140,12 +393,29 @@ void rcp_manager_clear(rcp_manager* manager)
             next = pe->next;
 
             rcp_parameter_free(pe->parameter);
-            RCP_MANAGER_MALLOC_DEBUG("+++ parameter list entry: %p\n", pe);
-            RCP_FREE(pe);
+            RCP_MANAGER_MALLOC_DEBUG("+++ manager entry: %p\n", pe);
+            rcp_pool_release(manager->entry_pool, pe);
 
             pe = next;
         }
         manager->parameters = NULL;
+        manager->parameter_count = 0;
+
+        rcp_idmap_clear(manager->parameter_map);
+
+        manager->snapshot_changed = NULL;
+        manager->snapshot_relayout = true;
+
+        _index_clear(&manager->label_index);
+        _index_clear(&manager->group_index);
+
+        if (manager->id_bits != NULL)
+        {
+            memset(manager->id_bits, 0, RCP_MANAGER_ID_WORDS * sizeof(uint32_t));
+            // id 0 is invalid
+            manager->id_bits[0] = 1;
+            manager->id_search_word = 0;
+        }
     }
 }
 
@@ -185,6 +455,15 @@ void rcp_manager_log(rcp_manager* manager)
     }
     RCP_INFO("\n");
 
+    RCP_INFO("---- throttled parameters ----\n");
+    pe = manager->throttled_parameters;
+    while (pe)
+    {
+        RCP_INFO("-- parameter id: %d\n", rcp_parameter_get_id(pe->parameter));
+        pe = pe->next;
+    }
+    RCP_INFO("\n");
+
     RCP_INFO("---- removed parameters ----\n");
     pe = manager->removed_parameters;
     while (pe)
@@ -202,81 +481,335 @@ rcp_parameter* rcp_manager_get_parameter(rcp_manager* manager, int16_t id)
 {
     if (manager == NULL) return NULL;
 
+    rcp_manager_entry* entry = (rcp_manager_entry*)rcp_idmap_get(manager->parameter_map, id);
+    if (entry == NULL) return NULL;
+
+    return entry->list.parameter;
+}
+
+rcp_parameter_list* rcp_manager_get_paramter_list(rcp_manager* manager)
+{
+    if (manager != NULL)
+    {
+        return manager->parameters;
+    }
+    return NULL;
+}
+
+static bool _create_id_bits(rcp_manager* manager)
+{
+    manager->id_bits = (uint32_t*)RCP_CALLOC(RCP_MANAGER_ID_WORDS, sizeof(uint32_t));
+    if (manager->id_bits == NULL)
+    {
+        RCP_ERROR("could not malloc id bits\n");
+        return false;
+    }
+
+    RCP_MANAGER_MALLOC_DEBUG("*** id bits: %p\n", manager->id_bits);
+
+    // id 0 is invalid
+    manager->id_bits[0] = 1;
+    manager->id_search_word = 0;
+
+    // mark ids in use and ids pending removal
     rcp_parameter_list* pe = manager->parameters;
     while (pe)
     {
-        if (rcp_parameter_get_id(pe->parameter) == id)
+        _mark_id(manager, rcp_parameter_get_id(pe->parameter));
+        pe = pe->next;
+    }
+
+    pe = manager->removed_parameters;
+    while (pe)
+    {
+        _mark_id(manager, rcp_parameter_get_id(pe->parameter));
+        pe = pe->next;
+    }
+
+    return true;
+}
+
+int16_t rcp_manager_get_available_id(rcp_manager* manager)
+{
+    if (manager == NULL) return 0;
+
+    if (manager->id_bits == NULL &&
+            !_create_id_bits(manager))
+    {
+        return 0;
+    }
+
+    for (uint32_t w = manager->id_search_word; w < RCP_MANAGER_ID_WORDS; w++)
+    {
+        if (manager->id_bits[w] != 0xFFFFFFFF)
         {
-            return pe->parameter;
+            manager->id_search_word = w;
+
+            // id is available
+            return (int16_t)(uint16_t)((w << 5) + (uint32_t)_first_zero_bit(manager->id_bits[w]));
         }
+    }
 
-        pe = pe->next;
+    // all ids in use
+    manager->id_search_word = RCP_MANAGER_ID_WORDS;
+    return 0;
+}
+
+//-------------------
+// label index
+
+static uint32_t _hash_label(int16_t parent_id, const char* label, size_t length)
+{
+    // FNV-1a
+    uint32_t hash = 2166136261u;
+
+    hash = (hash ^ (uint8_t)parent_id) * 16777619u;
+    hash = (hash ^ (uint8_t)((uint16_t)parent_id >> 8)) * 16777619u;
+
+    for (size_t i = 0; i < length; i++)
+    {
+        hash = (hash ^ (uint8_t)label[i]) * 16777619u;
     }
 
-    return NULL;
+    return hash;
 }
 
-rcp_parameter_list* rcp_manager_get_paramter_list(rcp_manager* manager)
+static void _index_unlink(rcp_manager_index* index, rcp_manager_entry* entry)
 {
-    if (manager != NULL)
+    rcp_manager_index_link* entry_link = _index_get_link(index, entry);
+    if (!entry_link->linked) return;
+
+    rcp_manager_entry** link = &index->buckets[entry_link->hash & (index->size - 1)];
+    while (*link != NULL)
     {
-        return manager->parameters;
+        if (*link == entry)
+        {
+            *link = entry_link->next;
+            break;
+        }
+
+        link = &_index_get_link(index, *link)->next;
     }
-    return NULL;
+
+    entry_link->next = NULL;
+    entry_link->linked = false;
+    index->count--;
 }
 
-static rcp_parameter* _get_removed_parameter(rcp_manager* manager, int16_t id)
+static bool _index_grow(rcp_manager_index* index)
 {
-    if (manager == NULL) return NULL;
+    uint32_t new_size = index->size > 0 ? index->size * 2 : RCP_MANAGER_INDEX_SIZE;
 
-    rcp_parameter_list* pe = manager->removed_parameters;
-    while (pe)
+    rcp_manager_entry** buckets = (rcp_manager_entry**)RCP_CALLOC(new_size, sizeof(rcp_manager_entry*));
+    if (buckets == NULL)
+    {
+        RCP_ERROR("could not malloc label index\n");
+        return false;
+    }
+
+    RCP_MANAGER_MALLOC_DEBUG("*** label index: %p\n", buckets);
+
+    // rehash
+    for (uint32_t i = 0; i < index->size; i++)
     {
-        if (rcp_parameter_get_id(pe->parameter) == id)
+        rcp_manager_entry* entry = index->buckets[i];
+        while (entry != NULL)
         {
-            return pe->parameter;
+            rcp_manager_index_link* link = _index_get_link(index, entry);
+            rcp_manager_entry* next = link->next;
+
+            link->next = buckets[link->hash & (new_size - 1)];
+            buckets[link->hash & (new_size - 1)] = entry;
+
+            entry = next;
         }
+    }
 
-        pe = pe->next;
+    if (index->buckets != NULL)
+    {
+        RCP_MANAGER_MALLOC_DEBUG("+++ label index: %p\n", index->buckets);
+        RCP_FREE(index->buckets);
     }
 
-    return NULL;
+    index->buckets = buckets;
+    index->size = new_size;
+
+    return true;
 }
 
+static void _index_put(rcp_manager_index* index, rcp_manager_entry* entry, uint32_t hash)
+{
+    rcp_manager_index_link* link = _index_get_link(index, entry);
 
-int16_t rcp_manager_get_available_id(rcp_manager* manager)
+    if (link->linked &&
+            link->hash == hash)
+    {
+        // same bucket
+        return;
+    }
+
+    _index_unlink(index, entry);
+
+    if (index->count >= index->size &&
+            !_index_grow(index))
+    {
+        return;
+    }
+
+    rcp_manager_entry** bucket = &index->buckets[hash & (index->size - 1)];
+
+    link->hash = hash;
+    link->next = *bucket;
+    link->linked = true;
+    *bucket = entry;
+    index->count++;
+}
+
+static void _index_entry(rcp_manager* manager, rcp_manager_entry* entry)
 {
-    if (manager == NULL) return 0;
+    rcp_parameter* parameter = entry->list.parameter;
+    const char* label = rcp_parameter_get_label(parameter);
+    size_t length = label != NULL ? strlen(label) : 0;
+
+    _index_put(&manager->label_index,
+               entry,
+               _hash_label(rcp_parameter_get_parent_id(parameter), label, length));
+
+    if (rcp_parameter_is_group(parameter))
+    {
+        _index_put(&manager->group_index, entry, _hash_label(0, label, length));
+    }
+}
+
+static void _index_remove(rcp_manager* manager, rcp_manager_entry* entry)
+{
+    _index_unlink(&manager->label_index, entry);
+    _index_unlink(&manager->group_index, entry);
+}
+
+// group_index: any parent
+static rcp_parameter* _index_find(rcp_manager* manager, int16_t parent_id, const char* label, size_t length, bool group_only)
+{
+    rcp_manager_index* index = &manager->label_index;
+    uint32_t hash = _hash_label(parent_id, label, length);
+
+    if (index->buckets == NULL) return NULL;
 
-    uint16_t i = 1;
-    while (i != 0)
+    rcp_manager_entry* entry = index->buckets[hash & (index->size - 1)];
+    while (entry != NULL)
     {
-        // look through list
-        if (rcp_manager_get_parameter(manager, (int16_t)i) == NULL &&
-                _get_removed_parameter(manager, (int16_t)i) == NULL)
+        if (entry->label_link.hash == hash)
         {
-            // id is available
-            return (int16_t)i;
+            rcp_parameter* parameter = entry->list.parameter;
+            const char* entry_label = rcp_parameter_get_label(parameter);
+
+            if (entry_label != NULL &&
+                    rcp_parameter_get_parent_id(parameter) == parent_id &&
+                    strncmp(entry_label, label, length) == 0 &&
+                    entry_label[length] == 0 &&
+                    (!group_only || rcp_parameter_is_group(parameter)))
+            {
+                return parameter;
+            }
         }
 
-        i++;
+        entry = entry->label_link.next;
     }
 
-    return 0;
+    return NULL;
+}
+
+// group with label on any level
+static rcp_parameter* _index_find_group(rcp_manager* manager, const char* label, size_t length)
+{
+    rcp_manager_index* index = &manager->group_index;
+    uint32_t hash = _hash_label(0, label, length);
+
+    if (index->buckets == NULL) return NULL;
+
+    rcp_manager_entry* entry = index->buckets[hash & (index->size - 1)];
+    while (entry != NULL)
+    {
+        if (entry->group_link.hash == hash)
+        {
+            const char* entry_label = rcp_parameter_get_label(entry->list.parameter);
+
+            if (entry_label != NULL &&
+                    strncmp(entry_label, label, length) == 0 &&
+                    entry_label[length] == 0)
+            {
+                return entry->list.parameter;
+            }
+        }
+
+        entry = entry->group_link.next;
+    }
+
+    return NULL;
+}
+
+// parameter needs to be serialized again for the snapshot
+static void _snapshot_invalidate(rcp_manager* manager, rcp_parameter* parameter)
+{
+    if (manager->snapshot == NULL)
+    {
+        // never built - everything is serialized on first use
+        return;
+    }
+
+    rcp_manager_entry* entry = (rcp_manager_entry*)rcp_idmap_get(manager->parameter_map, rcp_parameter_get_id(parameter));
+    if (entry != NULL &&
+            entry->list.parameter == parameter &&
+            !entry->snapshot_stale)
+    {
+        entry->snapshot_stale = true;
+        entry->snapshot_next = manager->snapshot_changed;
+        manager->snapshot_changed = entry;
+    }
+}
+
+// label or parent of parameter changed
+void rcp_manager_reindex_parameter(rcp_manager* manager, rcp_parameter* parameter)
+{
+    if (manager == NULL) return;
+    if (parameter == NULL) return;
+
+    rcp_manager_entry* entry = (rcp_manager_entry*)rcp_idmap_get(manager->parameter_map, rcp_parameter_get_id(parameter));
+    if (entry == NULL ||
+            entry->list.parameter != parameter)
+    {
+        // not in cache
+        return;
+    }
+
+    _index_entry(manager, entry);
+
+    // order of snapshot might change
+    _snapshot_invalidate(manager, parameter);
+    manager->snapshot_relayout = true;
 }
 
 static bool _do_add_parameter(rcp_manager* manager, rcp_parameter* parameter, bool is_server)
 {
-    rcp_parameter_list* new_list_item = RCP_CALLOC(1, sizeof(rcp_parameter_list));
+    rcp_manager_entry* new_entry = (rcp_manager_entry*)rcp_pool_alloc(manager->entry_pool);
+
+    if (new_entry == NULL)
+    {
+        RCP_ERROR("could not alloc manager entry!\n");
+        return false;
+    }
 
-    if (new_list_item == NULL)
+    if (!rcp_idmap_put(manager->parameter_map, rcp_parameter_get_id(parameter), new_entry))
     {
-        RCP_ERROR("could not alloc list entry for new child!\n");
+        RCP_MANAGER_MALLOC_DEBUG("+++ manager entry: %p\n", new_entry);
+        rcp_pool_release(manager->entry_pool, new_entry);
         return false;
     }
 
     // all ok
-    RCP_MANAGER_MALLOC_DEBUG("*** param list entry: %p\n", new_list_item);
+    RCP_MANAGER_MALLOC_DEBUG("*** manager entry: %p\n", new_entry);
+
+    rcp_parameter_list* new_list_item = &new_entry->list;
 
     // set manager
     rcp_parameter_set_manager(parameter, manager);
@@ -293,13 +826,25 @@ static bool _do_add_parameter(rcp_manager* manager, rcp_parameter* parameter, bo
     // setup list item
     new_list_item->parameter = parameter;
 
+    new_entry->snapshot_stale = true;
+    manager->snapshot_relayout = true;
+
     // add new parameter to beginning
+    new_list_item->prev = NULL;
     new_list_item->next = manager->parameters;
+    if (manager->parameters != NULL)
+    {
+        manager->parameters->prev = new_list_item;
+    }
     manager->parameters = new_list_item;
 
+    _index_entry(manager, new_entry);
+
     // count
     manager->parameter_count++;
 
+    _mark_id(manager, rcp_parameter_get_id(parameter));
+
     if (manager->parameterAddedCb)
     {
         manager->parameterAddedCb(parameter, manager->user);
@@ -326,6 +871,7 @@ bool rcp_manager_add_parameter(rcp_manager* manager, rcp_parameter* parameter, b
 }
 
 // return true if it was added
+// if the parameter is cached its option data is moved into the cached parameter
 bool rcp_manager_update_parameter(rcp_manager* manager, rcp_parameter* parameter, bool is_server)
 {
     if (manager == NULL) return false;
@@ -339,7 +885,10 @@ bool rcp_manager_update_parameter(rcp_manager* manager, rcp_parameter* parameter
         RCP_MANAGER_DEBUG("update cached parameter - server: %d\n", is_server);
 
         // update option chain
-        rcp_parameter_copy_from(cached_parameter, parameter);
+        // parameter is disposed by the caller - take its option data
+        rcp_parameter_move_from(cached_parameter, parameter);
+
+        _snapshot_invalidate(manager, cached_parameter);
     }
     else if (!is_server)
     {
@@ -360,184 +909,495 @@ bool rcp_manager_update_parameter(rcp_manager* manager, rcp_parameter* parameter
     return false;
 }
 
-bool rcp_manager_remove_parameter_id(rcp_manager* manager, int16_t parameter_id, bool is_server)
+/*
+ * apply an UPDATEVALUE packet to the cached parameter in place
+ *
+ * data points to the command byte
+ * returns a pointer to the data after the packet
+ * or NULL if the packet needs to be parsed regularly
+ * (parameter not cached, type missmatch, type not handled, not enough data)
+ */
+const char* rcp_manager_apply_value_update(rcp_manager* manager, const char* data, size_t* size)
 {
-    if (manager == NULL) return false;
+    if (manager == NULL) return NULL;
+    if (data == NULL) return NULL;
+    if (size == NULL) return NULL;
 
-    rcp_parameter_list* one_before = NULL;
-    rcp_parameter_list* entry = NULL;
-    rcp_parameter_list* next = NULL;
+    // command (1byte), id (2byte), typeid (1byte)
+    if (*size < 4) return NULL;
+    if (data[0] != COMMAND_UPDATEVALUE) return NULL;
 
-    // first remove id from dirty list
-    entry = manager->dirty_parameters;
-    while (entry)
-    {
-        next = entry->next;
+    size_t r_size = *size - 1;
+    int16_t id = 0;
+    const char* r_data = rcp_read_i16(data + 1, &r_size, &id);
+    if (r_data == NULL) return NULL;
 
-        if (rcp_parameter_get_id(entry->parameter) == parameter_id)
-        {
-            RCP_MANAGER_DEBUG("remove dirty parameter: %d\n", parameter_id);
+    rcp_parameter* parameter = rcp_manager_get_parameter(manager, id);
+    if (parameter == NULL) return NULL;
 
-            // remove from list
-            if (one_before == NULL)
-            {
-                manager->dirty_parameters = entry->next;
-            }
-            else
-            {
-                one_before->next = entry->next;
-            }
+    uint8_t type_id = 0;
+    r_data = rcp_read_u8(r_data, &r_size, &type_id);
+    if (r_data == NULL) return NULL;
 
-            // free this item
-            RCP_MANAGER_MALLOC_DEBUG("+++ dirty parameter list entry: %p\n", entry);
-            RCP_FREE(entry);
+    if (type_id != RCP_TYPE_ID(parameter))
+    {
+        RCP_MANAGER_DEBUG("updatevalue type missmatch: %d - %d\n", type_id, RCP_TYPE_ID(parameter));
+        return NULL;
+    }
 
-            // we only hold one parameter with that id
-            // ok to break
-            break;
-        }
-        else
-        {
-            one_before = entry;
-        }
+    r_data = rcp_parameter_apply_value(parameter, r_data, &r_size);
+    if (r_data == NULL) return NULL;
+
+    _snapshot_invalidate(manager, parameter);
+
+    *size = r_size;
+    return r_data;
+}
+
+// intrusive queues of dirty entries
+static void _queue_unlink(rcp_parameter_list** head, rcp_parameter_list** tail, rcp_parameter_list* entry)
+{
+    if (entry->prev != NULL)
+    {
+        entry->prev->next = entry->next;
+    }
+    else
+    {
+        *head = entry->next;
+    }
+
+    if (entry->next != NULL)
+    {
+        entry->next->prev = entry->prev;
+    }
+    else
+    {
+        *tail = entry->prev;
+    }
+
+    entry->next = NULL;
+    entry->prev = NULL;
+}
+
+// after NULL: insert at front
+static void _queue_insert_after(rcp_parameter_list** head, rcp_parameter_list** tail, rcp_parameter_list* after, rcp_parameter_list* entry)
+{
+    entry->prev = after;
+    entry->next = after != NULL ? after->next : *head;
+
+    if (entry->next != NULL)
+    {
+        entry->next->prev = entry;
+    }
+    else
+    {
+        *tail = entry;
+    }
+
+    if (after != NULL)
+    {
+        after->next = entry;
+    }
+    else
+    {
+        *head = entry;
+    }
+}
+
+// remove parameter from dirty or throttled queue
+static void _unqueue_parameter(rcp_manager* manager, rcp_parameter* parameter)
+{
+    if (!rcp_parameter_is_queued(parameter)) return;
+
+    rcp_parameter_list* entry = rcp_parameter_get_dirty_entry(parameter);
+
+    if (rcp_parameter_is_throttled(parameter))
+    {
+        _queue_unlink(&manager->throttled_parameters, &manager->throttled_tail, entry);
+        rcp_parameter_set_throttled(parameter, false);
+    }
+    else
+    {
+        _queue_unlink(&manager->dirty_parameters, &manager->dirty_tail, entry);
+    }
+
+    manager->dirty_count--;
+
+    rcp_parameter_set_queued(parameter, false);
+}
+
+// remove entry and all children of groups
+// INFO: entry must be in parameter map
+static void _remove_entry(rcp_manager* manager, rcp_manager_entry* manager_entry, bool is_server)
+{
+    rcp_parameter_list* entry = &manager_entry->list;
+    rcp_parameter* parameter = entry->parameter;
+    int16_t parameter_id = rcp_parameter_get_id(parameter);
+
+    RCP_MANAGER_DEBUG("remove parameter: %d\n", parameter_id);
+
+    rcp_idmap_remove(manager->parameter_map, parameter_id);
+    _index_remove(manager, manager_entry);
+
+    // first remove parameter from dirty queue
+    _unqueue_parameter(manager, parameter);
+
+    // second remove from parameter list
+    if (entry->prev != NULL)
+    {
+        entry->prev->next = entry->next;
+    }
+    else
+    {
+        manager->parameters = entry->next;
+    }
 
-        entry = next;
+    if (entry->next != NULL)
+    {
+        entry->next->prev = entry->prev;
     }
 
+    entry->next = NULL;
+    entry->prev = NULL;
 
-    // second remove parameter
-    one_before = NULL;
-    entry = manager->parameters;
-    while (entry)
+    manager->parameter_count--;
+    manager->snapshot_relayout = true;
+
+    //
+    if (manager->parameterRemovedCb)
     {
-        next = entry->next;
+        manager->parameterRemovedCb(parameter, manager->user);
+    }
 
-        if (rcp_parameter_get_id(entry->parameter) == parameter_id)
+
+    if (rcp_parameter_is_group(parameter))
+    {
+        // also remove children
+        rcp_parameter_list* children = rcp_group_get_children(RCP_GROUP_PARAMETER(parameter));
+        rcp_parameter_list* next;
+        while (children != NULL)
         {
-            RCP_MANAGER_DEBUG("remove parameter: %d\n", parameter_id);
+            // removing a child unlinks it from children list
+            next = children->next;
 
-            // remove from list
-            if (one_before == NULL)
-            {
-                manager->parameters = entry->next;
-            }
-            else
+            rcp_manager_entry* child_entry = (rcp_manager_entry*)rcp_idmap_get(manager->parameter_map, rcp_parameter_get_id(children->parameter));
+            if (child_entry != NULL &&
+                    child_entry->list.parameter == children->parameter)
             {
-                one_before->next = entry->next;
+                // INFO: pass is_server = false to free parameter
+                // on server:
+                //      we only need to send remove for the outer most group parameter
+                //      all other parameters can get destroyed immediately
+                // on client:
+                //      we also destroy the outer most group parameter
+                _remove_entry(manager, child_entry, false);
             }
 
-            manager->parameter_count--;
+            children = next;
+        }
+    }
 
-            //
-            if (manager->parameterRemovedCb)
-            {
-                manager->parameterRemovedCb(entry->parameter, manager->user);
-            }
 
+    if (is_server)
+    {
+        // add to removed parameter list
+        // server sends remove command on next update
+        // INFO: parameter gets freed after sending that remove command
+
+        // recycle that list-item
+        entry->next = manager->removed_parameters;
+        manager->removed_parameters = entry;
+        manager->removed_count++;
+    }
+    else
+    {
+        _release_id(manager, parameter_id);
 
-            if (rcp_parameter_is_group(entry->parameter))
-            {
-                // also remove children
-                rcp_parameter_list* children = rcp_group_get_children(RCP_GROUP_PARAMETER(entry->parameter));
-                while (children != NULL)
-                {
-                    // INFO: pass is_server = false to free parameter
-                    // on server:
-                    //      we only need to send remove for the outer most group parameter
-                    //      all other parameters can get destroyed immediately
-                    // on client:
-                    //      we also destroy the outer most group parameter
-                    rcp_manager_remove_parameter_id(manager, rcp_parameter_get_id(children->parameter), false);
-                    children = children->next;
-                }
-            }
+        // free parameter
+        rcp_parameter_free(parameter);
 
+        // free list item
+        RCP_MANAGER_MALLOC_DEBUG("+++ manager entry: %p\n", manager_entry);
+        rcp_pool_release(manager->entry_pool, manager_entry);
+    }
+}
 
-            if (is_server)
-            {
-                // add to removed parameter list
-                // server sends remove command on next update
-                // INFO: parameter gets freed after sending that remove command
+bool rcp_manager_remove_parameter_id(rcp_manager* manager, int16_t parameter_id, bool is_server)
+{
+    if (manager == NULL) return false;
 
-                // recycle that list-item
-                entry->next = manager->removed_parameters;
-                manager->removed_parameters = entry;
-            }
-            else
-            {
-                // free parameter
-                rcp_parameter_free(entry->parameter);
+    rcp_manager_entry* manager_entry = (rcp_manager_entry*)rcp_idmap_get(manager->parameter_map, parameter_id);
+    if (manager_entry == NULL)
+    {
+        // not in cache
+        return false;
+    }
 
-                // free list item
-                RCP_MANAGER_MALLOC_DEBUG("+++ parameter list entry: %p\n", entry);
-                RCP_FREE(entry);
-            }
+    _remove_entry(manager, manager_entry, is_server);
 
-            return true;
+    return true;
+}
+
+
+// send out pending frame
+static void _flush_frame(rcp_manager* manager)
+{
+    if (manager->frame_size == 0) return;
+
+    if (manager->frame_to_one)
+    {
+        if (manager->sendDataCbOne != NULL)
+        {
+            manager->sendDataCbOne(manager->user, manager->write_buffer, manager->frame_size, manager->frame_client);
         }
+    }
+    else if (manager->sendDataCbAll != NULL)
+    {
+        manager->sendDataCbAll(manager->user, manager->write_buffer, manager->frame_size);
+    }
 
-        one_before = entry;
-        entry = next;
+    manager->frame_size = 0;
+}
+
+// add packet written behind pending frame to the frame
+// packets are collected into one frame if a max frame size is set
+// responses to one client use the init frame size
+static void _frame_packet(rcp_manager* manager, size_t written)
+{
+    size_t max_frame_size = manager->frame_to_one ? manager->init_frame_size : manager->max_frame_size;
+
+    if (manager->frame_size > 0 &&
+            manager->frame_size + written > max_frame_size)
+    {
+        // packet does not fit into current frame
+        // send frame and move packet to front
+        size_t frame_size = manager->frame_size;
+        _flush_frame(manager);
+        memmove(manager->write_buffer, manager->write_buffer + frame_size, written);
     }
 
-    return false;
+    manager->frame_size += written;
+
+    if (manager->frame_size >= max_frame_size)
+    {
+        // frame is full, or batching is disabled
+        _flush_frame(manager);
+    }
 }
 
+// serialize packet into write buffer
+// returns the number of bytes written
+static size_t _send_packet(rcp_manager* manager, rcp_packet* packet)
+{
+    // write in one pass behind pending frame
+    size_t written = rcp_packet_write_grow(packet,
+                                           &manager->write_buffer,
+                                           &manager->write_buffer_size,
+                                           manager->frame_size,
+                                           false);
+    if (written == 0)
+    {
+        return 0;
+    }
+
+    _frame_packet(manager, written);
+
+    return written;
+}
+
+void rcp_manager_set_max_frame_size(rcp_manager* manager, size_t size)
+{
+    if (manager == NULL) return;
+
+    manager->max_frame_size = size;
+}
+
+size_t rcp_manager_get_max_frame_size(rcp_manager* manager)
+{
+    if (manager == NULL) return 0;
+
+    return manager->max_frame_size;
+}
+
+void rcp_manager_set_init_frame_size(rcp_manager* manager, size_t size)
+{
+    if (manager == NULL) return;
+
+    manager->init_frame_size = size;
+}
+
+size_t rcp_manager_get_init_frame_size(rcp_manager* manager)
+{
+    if (manager == NULL) return 0;
+
+    return manager->init_frame_size;
+}
 
 void rcp_manager_set_dirty(rcp_manager* manager, rcp_parameter* parameter)
 {
     if (manager == NULL) return;
     if (parameter == NULL) return;
 
-    rcp_parameter_list* pl = manager->dirty_parameters;
-    while (pl)
-	{
-        if (pl->parameter == parameter ||
-			rcp_parameter_get_id(pl->parameter) == rcp_parameter_get_id(parameter))
-		{
-            // already in list
-            return;
-        }
+    // also if queued - the snapshot might contain a previous state
+    _snapshot_invalidate(manager, parameter);
 
-        pl = pl->next;
+    if (rcp_parameter_is_queued(parameter))
+    {
+        // already in queue
+        return;
     }
 
-    // add to dirty-list
-    rcp_parameter_list* new_entry = RCP_CALLOC(1, sizeof(rcp_parameter_list));
-    if (new_entry)
-	{
-        RCP_MANAGER_MALLOC_DEBUG("*** dirty parameter list entry: %p\n", new_entry);
+    // append to dirty queue
+    _queue_insert_after(&manager->dirty_parameters,
+                        &manager->dirty_tail,
+                        manager->dirty_tail,
+                        rcp_parameter_get_dirty_entry(parameter));
+    manager->dirty_count++;
+
+    rcp_parameter_set_queued(parameter, true);
+}
+
+// get monotonic time in nanoseconds
+// returns false if no clock is available
+static bool _get_time(rcp_manager* manager, uint64_t* now)
+{
+    if (manager->clockCb != NULL)
+    {
+        *now = manager->clockCb(manager->user);
+        return true;
+    }
 
-		new_entry->parameter = parameter;
-        new_entry->next = manager->dirty_parameters;
-        manager->dirty_parameters = new_entry;
+#if defined(_WIN32)
+    LARGE_INTEGER frequency;
+    LARGE_INTEGER counter;
+    if (QueryPerformanceFrequency(&frequency) &&
+            QueryPerformanceCounter(&counter))
+    {
+        *now = (uint64_t)((double)counter.QuadPart * 1000000000.0 / (double)frequency.QuadPart);
+        return true;
     }
-    else
+#elif defined(CLOCK_MONOTONIC)
+    struct timespec ts;
+    if (clock_gettime(CLOCK_MONOTONIC, &ts) == 0)
+    {
+        *now = (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+        return true;
+    }
+#endif
+
+    return false;
+}
+
+static bool _budget_spent(rcp_manager* manager, size_t count, size_t bytes, size_t max_bytes, bool timed, uint64_t start, uint64_t max_ns)
+{
+    // always make progress
+    if (count == 0) return false;
+
+    if (max_bytes > 0 &&
+            bytes >= max_bytes)
+    {
+        return true;
+    }
+
+    if (timed)
+    {
+        uint64_t now;
+        if (_get_time(manager, &now) &&
+                now - start >= max_ns)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// earliest time a rate limited parameter may be sent again
+static uint64_t _next_send_time(rcp_parameter* parameter)
+{
+    return rcp_parameter_get_last_sent(parameter) +
+            (uint64_t)rcp_parameter_get_effective_send_interval(parameter) * 1000000ULL;
+}
+
+// move dirty parameter to throttled queue - ordered by next send time
+static void _throttle_parameter(rcp_manager* manager, rcp_parameter* parameter)
+{
+    rcp_parameter_list* entry = rcp_parameter_get_dirty_entry(parameter);
+    _queue_unlink(&manager->dirty_parameters, &manager->dirty_tail, entry);
+
+    // mostly appended - same interval
+    uint64_t next_time = _next_send_time(parameter);
+    rcp_parameter_list* after = manager->throttled_tail;
+    while (after != NULL &&
+           _next_send_time(after->parameter) > next_time)
+    {
+        after = after->prev;
+    }
+
+    _queue_insert_after(&manager->throttled_parameters, &manager->throttled_tail, after, entry);
+    rcp_parameter_set_throttled(parameter, true);
+}
+
+// move throttled parameters which are due to the front of the dirty queue
+static void _release_throttled(rcp_manager* manager, bool has_time, uint64_t now)
+{
+    rcp_parameter_list* after = NULL;
+
+    while (manager->throttled_parameters != NULL &&
+           (!has_time || _next_send_time(manager->throttled_parameters->parameter) <= now))
     {
-        RCP_ERROR("could not alloc list element for dirty parameter\n");
+        rcp_parameter_list* entry = manager->throttled_parameters;
+        _queue_unlink(&manager->throttled_parameters, &manager->throttled_tail, entry);
+        rcp_parameter_set_throttled(entry->parameter, false);
+
+        _queue_insert_after(&manager->dirty_parameters, &manager->dirty_tail, after, entry);
+        after = entry;
     }
 }
 
 void rcp_manager_update(rcp_manager* manager)
 {
-    if (manager == NULL) return;
+    rcp_manager_update_budget(manager, 0, 0);
+}
+
+// send removed and dirty parameters until budget is spent
+// max_bytes: 0: unlimited - the last packet might exceed the budget
+// max_ns: 0: unlimited - needs a clock (see rcp_manager_set_clock_cb)
+// returns the number of parameters still pending
+size_t rcp_manager_update_budget(rcp_manager* manager, size_t max_bytes, uint64_t max_ns)
+{
+    if (manager == NULL) return 0;
 
-    rcp_packet* packet;
-    size_t data_out_size = 0;
-    char* data_out = NULL;
+    // reuse send packet - nested calls create their own
+    rcp_packet* packet = manager->send_packet;
+    manager->send_packet = NULL;
+
+    if (packet == NULL)
+    {
+        packet = rcp_packet_create(COMMAND_INVALID);
+    }
 
     rcp_parameter_list* pl;
     rcp_parameter_list* next;
 
+    size_t count = 0;
+    size_t bytes = 0;
+    uint64_t start = 0;
+    bool has_time = _get_time(manager, &start);
+    bool timed = has_time && max_ns > 0;
+
     //-----------------------------
     // send remove parameters first
     if (manager->removed_parameters != NULL)
     {
-        pl = manager->removed_parameters;
-        packet = rcp_packet_create(COMMAND_REMOVE);
-        while (pl)
+        rcp_packet_reset(packet, COMMAND_REMOVE);
+        while (manager->removed_parameters != NULL &&
+               !_budget_spent(manager, count, bytes, max_bytes, timed, start, max_ns))
         {
-            next = pl->next;
+            pl = manager->removed_parameters;
+            manager->removed_parameters = pl->next;
+            manager->removed_count--;
+            count++;
 
             // only serialize if we have a callback
             if (packet &&
@@ -545,48 +1405,56 @@ void rcp_manager_update(rcp_manager* manager)
             {
                 rcp_packet_set_iddata(packet, rcp_parameter_get_id(pl->parameter));
 
-                data_out_size = rcp_packet_write(packet, &data_out, false);
-
-                if (data_out_size > 0 &&
-                        data_out != NULL)
-                {
-                    // send it out...
-                    manager->sendDataCbAll(manager->user, data_out, data_out_size);
-
-                    RCP_MANAGER_MALLOC_DEBUG("+++ data out: %p\n", data_out);
-                    RCP_FREE(data_out);
-                    data_out = NULL;
-                }
+                // send it out...
+                bytes += _send_packet(manager, packet);
             }
 
-            // free parameter and list entry
-            rcp_parameter_free(pl->parameter);
-            RCP_MANAGER_MALLOC_DEBUG("+++ parameter list entry: %p\n", pl);
-            RCP_FREE(pl);
+            // id is available again
+            _release_id(manager, rcp_parameter_get_id(pl->parameter));
 
-            pl = next;
+            // free parameter and manager entry
+            rcp_parameter_free(pl->parameter);
+            RCP_MANAGER_MALLOC_DEBUG("+++ manager entry: %p\n", pl);
+            rcp_pool_release(manager->entry_pool, pl);
         } // while
-
-        manager->removed_parameters = NULL;
-
-        if (packet)
-        {
-            rcp_packet_free(packet);
-            packet = NULL;
-        }
     }
 
 
     //-----------------------------
-    // send < parameters
+    // send dirty parameters
+    _release_throttled(manager, has_time, start);
+
     if (manager->dirty_parameters != NULL)
     {
         pl = manager->dirty_parameters;
-        packet = rcp_packet_create(COMMAND_UPDATE);
-        while (pl != NULL)
+        rcp_packet_reset(packet, COMMAND_UPDATE);
+        while (pl != NULL &&
+               !_budget_spent(manager, count, bytes, max_bytes, timed, start, max_ns))
         {
             next = pl->next;
 
+            if (has_time)
+            {
+                // last sent 0: never sent
+                uint32_t interval = rcp_parameter_get_effective_send_interval(pl->parameter);
+                uint64_t last_sent = rcp_parameter_get_last_sent(pl->parameter);
+                if (interval > 0 &&
+                        last_sent != 0 &&
+                        start - last_sent < (uint64_t)interval * 1000000ULL)
+                {
+                    // rate limited - wait in throttled queue
+                    _throttle_parameter(manager, pl->parameter);
+                    pl = next;
+                    continue;
+                }
+
+                rcp_parameter_set_last_sent(pl->parameter, start != 0 ? start : 1);
+            }
+
+            // remove from dirty queue
+            _unqueue_parameter(manager, pl->parameter);
+            count++;
+
     //        RCP_MANAGER_DEBUG("sending dirty parameter(%d) - %p\n", parameter_get_id(pl->parameter), pl->parameter);
 
             if (packet &&
@@ -605,34 +1473,605 @@ void rcp_manager_update(rcp_manager* manager)
                 // set parameter (no transfer)
                 rcp_packet_set_parameter(packet, pl->parameter);
 
-                data_out_size = rcp_packet_write(packet, &data_out, false);
+                // send it out...
+                bytes += _send_packet(manager, packet);
+            }
 
-                if (data_out_size > 0 &&
-                        data_out != NULL)
-                {
-                    // send it out...
-                    manager->sendDataCbAll(manager->user, data_out, data_out_size);
+            pl = next;
+        } // while
+    }
+
+    // send out remaining packets
+    _flush_frame(manager);
+
+    if (packet != NULL)
+    {
+        if (manager->send_packet == NULL)
+        {
+            // keep it - drop parameter reference
+            rcp_packet_reset(packet, COMMAND_INVALID);
+            manager->send_packet = packet;
+        }
+        else
+        {
+            rcp_packet_free(packet);
+        }
+    }
+
+    return manager->removed_count + manager->dirty_count;
+}
 
-                    RCP_MANAGER_MALLOC_DEBUG("+++ data out: %p\n", data_out);
-                    RCP_FREE(data_out);
-                    data_out = NULL;
+// lists are prepended - last item was added first
+static rcp_parameter_list* _list_last(rcp_parameter_list* list)
+{
+    while (list != NULL &&
+           list->next != NULL)
+    {
+        list = list->next;
+    }
+
+    return list;
+}
+
+// remember end of packet in snapshot
+static bool _snapshot_add_end(rcp_manager* manager, size_t end)
+{
+    if (manager->snapshot_ends_count >= manager->snapshot_ends_size)
+    {
+        size_t new_size = manager->snapshot_ends_size > 0 ? manager->snapshot_ends_size * 2 : 64;
+        size_t* new_ends = (size_t*)RCP_REALLOC(manager->snapshot_ends, new_size * sizeof(size_t));
+        if (new_ends == NULL)
+        {
+            RCP_ERROR("could not grow snapshot ends\n");
+            return false;
+        }
+
+        RCP_MANAGER_MALLOC_DEBUG("*** snapshot ends: %p\n", new_ends);
+
+        manager->snapshot_ends = new_ends;
+        manager->snapshot_ends_size = new_size;
+    }
+
+    manager->snapshot_ends[manager->snapshot_ends_count++] = end;
+    return true;
+}
+
+// append serialized parameter and its children to the back buffer
+// unchanged parameters are copied from the current snapshot
+static bool _snapshot_write_entry(rcp_manager* manager, rcp_manager_entry* entry, rcp_packet* packet, size_t* offset)
+{
+    size_t written = 0;
+
+    if (!entry->snapshot_stale &&
+            manager->snapshot != NULL)
+    {
+        if (!rcp_packet_reserve_buffer(&manager->snapshot_back, &manager->snapshot_back_size, *offset + entry->snapshot_size))
+        {
+            return false;
+        }
+
+        memcpy(manager->snapshot_back + *offset, manager->snapshot + entry->snapshot_offset, entry->snapshot_size);
+        written = entry->snapshot_size;
+    }
+    else
+    {
+        rcp_packet_set_parameter(packet, entry->list.parameter);
+
+        written = rcp_packet_write_grow(packet,
+                                        &manager->snapshot_back,
+                                        &manager->snapshot_back_size,
+                                        *offset,
+                                        true);
+        if (written == 0)
+        {
+            // skip it - serialized again on its next change
+            RCP_ERROR("could not write parameter %d to snapshot - skipped\n", rcp_parameter_get_id(entry->list.parameter));
+        }
+    }
+
+    entry->snapshot_offset = *offset;
+    entry->snapshot_size = written;
+    entry->snapshot_stale = false;
+    *offset += written;
+
+    if (written > 0 &&
+            !_snapshot_add_end(manager, *offset))
+    {
+        return false;
+    }
+
+    if (rcp_parameter_is_group(entry->list.parameter))
+    {
+        // children follow their group
+        rcp_parameter_list* child = _list_last(rcp_group_get_children(RCP_GROUP_PARAMETER(entry->list.parameter)));
+        while (child != NULL)
+        {
+            // skip parameters pending removal
+            rcp_manager_entry* child_entry = (rcp_manager_entry*)rcp_idmap_get(manager->parameter_map, rcp_parameter_get_id(child->parameter));
+            if (child_entry != NULL &&
+                    child_entry->list.parameter == child->parameter)
+            {
+                if (!_snapshot_write_entry(manager, child_entry, packet, offset))
+                {
+                    return false;
                 }
             }
 
-            // remove list element
-            RCP_MANAGER_MALLOC_DEBUG("+++ dirty parameter list entry: %p\n", pl);
-            RCP_FREE(pl);
+            child = child->prev;
+        }
+    }
 
-            pl = next;
-        } // while
+    return true;
+}
 
-        manager->dirty_parameters = NULL;
+// serialize all parameters on next rebuild
+static void _snapshot_all_stale(rcp_manager* manager)
+{
+    manager->snapshot_relayout = true;
 
-        //
-        if (packet)
+    rcp_parameter_list* pl = manager->parameters;
+    while (pl != NULL)
+    {
+        ((rcp_manager_entry*)pl)->snapshot_stale = true;
+        pl = pl->next;
+    }
+}
+
+// serialize all parameters into the back buffer and swap buffers
+// parameters which can not be written are skipped
+// returns false if out of memory
+static bool _snapshot_rebuild(rcp_manager* manager, rcp_packet* packet)
+{
+    bool ok = true;
+    size_t offset = 0;
+
+    manager->snapshot_ends_count = 0;
+
+    // parents first: walk top level parameters in order of creation
+    rcp_parameter_list* pl = _list_last(manager->parameters);
+    while (pl != NULL && ok)
+    {
+        if (rcp_parameter_get_parent(pl->parameter) == NULL)
+        {
+            ok = _snapshot_write_entry(manager, (rcp_manager_entry*)pl, packet, &offset);
+        }
+
+        pl = pl->prev;
+    }
+
+    if (ok)
+    {
+        // clients expect INITIALIZE after all parameters
+        ok = rcp_packet_reserve_buffer(&manager->snapshot_back, &manager->snapshot_back_size, offset + 2);
+        if (ok)
+        {
+            manager->snapshot_back[offset++] = COMMAND_INITIALIZE;
+            manager->snapshot_back[offset++] = RCP_TERMINATOR;
+
+            ok = _snapshot_add_end(manager, offset);
+        }
+    }
+
+    // all entries got visited - entries pending removal are not touched
+    manager->snapshot_changed = NULL;
+
+    if (!ok)
+    {
+        // entries might point into the back buffer - serialize all next time
+        _snapshot_all_stale(manager);
+        return false;
+    }
+
+    // swap buffers
+    char* buffer = manager->snapshot;
+    size_t buffer_size = manager->snapshot_buffer_size;
+
+    manager->snapshot = manager->snapshot_back;
+    manager->snapshot_buffer_size = manager->snapshot_back_size;
+    manager->snapshot_size = offset;
+
+    manager->snapshot_back = buffer;
+    manager->snapshot_back_size = buffer_size;
+
+    manager->snapshot_relayout = false;
+
+    return true;
+}
+
+// serialize changed parameters again
+// returns false if a size changed - the snapshot needs to be rebuilt
+static bool _snapshot_patch(rcp_manager* manager, rcp_packet* packet)
+{
+    while (manager->snapshot_changed != NULL)
+    {
+        rcp_manager_entry* entry = manager->snapshot_changed;
+
+        rcp_packet_set_parameter(packet, entry->list.parameter);
+
+        size_t written = rcp_packet_write_grow(packet,
+                                               &manager->snapshot_back,
+                                               &manager->snapshot_back_size,
+                                               0,
+                                               true);
+        if (written != entry->snapshot_size)
+        {
+            return false;
+        }
+
+        memcpy(manager->snapshot + entry->snapshot_offset, manager->snapshot_back, written);
+
+        manager->snapshot_changed = entry->snapshot_next;
+        entry->snapshot_next = NULL;
+        entry->snapshot_stale = false;
+    }
+
+    return true;
+}
+
+/*
+ * serialized full state for initializing clients
+ *
+ * UPDATE packets of all parameters - groups before their children -
+ * followed by INITIALIZE
+ * parameters which can not be written are left out
+ * only changed parameters are serialized again
+ * with external getters values can change anytime - all are serialized
+ *
+ * no transfer - data is valid until the next change of a parameter
+ * returns NULL if out of memory
+ */
+const char* rcp_manager_get_snapshot(rcp_manager* manager, size_t* size)
+{
+    if (manager == NULL) return NULL;
+    if (size == NULL) return NULL;
+
+    *size = 0;
+
+#ifdef RCP_OPTION_USE_EXTERNAL_GET_SET
+    // values are not cached - don't reuse anything
+    _snapshot_all_stale(manager);
+#endif
+
+    if (manager->snapshot == NULL ||
+            manager->snapshot_relayout ||
+            manager->snapshot_changed != NULL)
+    {
+        // reuse send packet - nested calls create their own
+        rcp_packet* packet = manager->send_packet;
+        manager->send_packet = NULL;
+
+        if (packet == NULL)
+        {
+            packet = rcp_packet_create(COMMAND_UPDATE);
+            if (packet == NULL)
+            {
+                return NULL;
+            }
+        }
+
+        rcp_packet_reset(packet, COMMAND_UPDATE);
+
+        bool ok = true;
+        if (manager->snapshot == NULL ||
+                manager->snapshot_relayout ||
+                !_snapshot_patch(manager, packet))
+        {
+            ok = _snapshot_rebuild(manager, packet);
+        }
+
+        if (manager->send_packet == NULL)
+        {
+            // keep it - drop parameter reference
+            rcp_packet_reset(packet, COMMAND_INVALID);
+            manager->send_packet = packet;
+        }
+        else
         {
             rcp_packet_free(packet);
         }
+
+        if (!ok)
+        {
+            return NULL;
+        }
+    }
+
+    *size = manager->snapshot_size;
+    return manager->snapshot;
+}
+
+// send snapshot to one client in frames up to init frame size
+// init frame size 0: one packet per frame
+// a packet bigger than init frame size is sent in its own frame
+// returns the number of bytes sent
+size_t rcp_manager_send_snapshot(rcp_manager* manager, void* client)
+{
+    if (manager == NULL) return 0;
+    if (manager->sendDataCbOne == NULL) return 0;
+
+    size_t size = 0;
+    const char* data = rcp_manager_get_snapshot(manager, &size);
+    if (data == NULL)
+    {
+        // out of memory - clients still wait for INITIALIZE
+        char init[2] = { COMMAND_INITIALIZE, RCP_TERMINATOR };
+        manager->sendDataCbOne(manager->user, init, 2, client);
+        return 2;
+    }
+
+    size_t start = 0;
+    size_t i = 0;
+    while (i < manager->snapshot_ends_count)
+    {
+        // at least one packet per frame
+        size_t end = manager->snapshot_ends[i++];
+
+        while (i < manager->snapshot_ends_count &&
+               manager->snapshot_ends[i] - start <= manager->init_frame_size)
+        {
+            end = manager->snapshot_ends[i++];
+        }
+
+        manager->sendDataCbOne(manager->user, data + start, end - start, client);
+        start = end;
+    }
+
+    return size;
+}
+
+// write UPDATE packet of parameter behind pending frame
+// metadata: without value
+static size_t _send_parameter(rcp_manager* manager, rcp_packet* packet, rcp_parameter* parameter, bool metadata)
+{
+    size_t written = 0;
+
+    if (metadata)
+    {
+        // metadata is never bigger than the whole parameter - command(1) + data option(1) + terminator(1)
+        size_t size = rcp_parameter_get_size(parameter, true) + 3;
+        if (!rcp_packet_reserve_buffer(&manager->write_buffer, &manager->write_buffer_size, manager->frame_size + size))
+        {
+            return 0;
+        }
+
+        written = rcp_parameter_write_metadata_packet(parameter, manager->write_buffer + manager->frame_size, size);
+    }
+    else
+    {
+        rcp_packet_set_parameter(packet, parameter);
+
+        written = rcp_packet_write_grow(packet,
+                                        &manager->write_buffer,
+                                        &manager->write_buffer_size,
+                                        manager->frame_size,
+                                        true);
+    }
+
+    if (written == 0)
+    {
+        RCP_ERROR("could not write parameter %d\n", rcp_parameter_get_id(parameter));
+        return 0;
+    }
+
+    _frame_packet(manager, written);
+
+    return written;
+}
+
+// send children of a group in order of creation - recursive: also children of child groups
+static size_t _send_children(rcp_manager* manager, rcp_packet* packet, rcp_parameter_list* children, bool top_level, bool metadata, bool recursive)
+{
+    size_t count = 0;
+
+    // in order of creation
+    while (children != NULL)
+    {
+        // skip parameters pending removal
+        rcp_manager_entry* entry = (rcp_manager_entry*)rcp_idmap_get(manager->parameter_map, rcp_parameter_get_id(children->parameter));
+
+        if (entry != NULL &&
+                entry->list.parameter == children->parameter &&
+                (!top_level || rcp_parameter_get_parent(children->parameter) == NULL))
+        {
+            if (_send_parameter(manager, packet, children->parameter, metadata) > 0)
+            {
+                count++;
+            }
+
+            if (recursive &&
+                    rcp_parameter_is_group(children->parameter))
+            {
+                count += _send_children(manager,
+                                        packet,
+                                        _list_last(rcp_group_get_children(RCP_GROUP_PARAMETER(children->parameter))),
+                                        false,
+                                        metadata,
+                                        recursive);
+            }
+        }
+
+        children = children->prev;
+    }
+
+    return count;
+}
+
+// start frames to one client - returns the packet to write with
+static rcp_packet* _begin_send_to_one(rcp_manager* manager, void* client)
+{
+    // reuse send packet - nested calls create their own
+    rcp_packet* packet = manager->send_packet;
+    manager->send_packet = NULL;
+
+    if (packet == NULL)
+    {
+        packet = rcp_packet_create(COMMAND_UPDATE);
+        if (packet == NULL)
+        {
+            return NULL;
+        }
+    }
+
+    rcp_packet_reset(packet, COMMAND_UPDATE);
+
+    // send out anything pending for all clients first
+    _flush_frame(manager);
+    manager->frame_to_one = true;
+    manager->frame_client = client;
+
+    return packet;
+}
+
+static void _end_send_to_one(rcp_manager* manager, rcp_packet* packet)
+{
+    _flush_frame(manager);
+    manager->frame_to_one = false;
+    manager->frame_client = NULL;
+
+    if (manager->send_packet == NULL)
+    {
+        // keep it - drop parameter reference
+        rcp_packet_reset(packet, COMMAND_INVALID);
+        manager->send_packet = packet;
+    }
+    else
+    {
+        rcp_packet_free(packet);
+    }
+}
+
+// end_response: end with INITIALIZE carrying the id
+static size_t _send_parameters(rcp_manager* manager, int16_t id, bool metadata, bool recursive, bool end_response, void* client)
+{
+    if (manager == NULL) return 0;
+    if (manager->sendDataCbOne == NULL) return 0;
+
+    rcp_parameter_list* children = NULL;
+    rcp_parameter* parameter = NULL;
+
+    if (id != 0)
+    {
+        parameter = rcp_manager_get_parameter(manager, id);
+        if (parameter == NULL)
+        {
+            RCP_MANAGER_DEBUG("no parameter with id: %d\n", id);
+        }
+        else if (rcp_parameter_is_group(parameter))
+        {
+            children = _list_last(rcp_group_get_children(RCP_GROUP_PARAMETER(parameter)));
+        }
+    }
+    else
+    {
+        children = _list_last(manager->parameters);
+    }
+
+    rcp_packet* packet = _begin_send_to_one(manager, client);
+    if (packet == NULL) return 0;
+
+    size_t count = 0;
+
+    if (parameter != NULL &&
+            _send_parameter(manager, packet, parameter, metadata) > 0)
+    {
+        count++;
+    }
+
+    count += _send_children(manager, packet, children, id == 0, metadata, recursive);
+
+    if (end_response)
+    {
+        // end of response
+        rcp_packet_reset(packet, COMMAND_INITIALIZE);
+        if (id != 0)
+        {
+            rcp_packet_set_iddata(packet, id);
+        }
+
+        if (_send_packet(manager, packet) == 0)
+        {
+            RCP_ERROR("could not write end of response: %d\n", id);
+        }
+    }
+
+    _end_send_to_one(manager, packet);
+
+    return count;
+}
+
+/*
+ * send a parameter and the direct children of a group to one client
+ * used for DISCOVER and INITIALIZE with id
+ *
+ * id 0: all top level parameters
+ * metadata: without values
+ *
+ * the response ends with INITIALIZE carrying the id - also if there is
+ * no parameter with this id
+ * packets are sent in frames up to init frame size - 0: one packet per frame
+ * returns the number of parameters sent
+ */
+size_t rcp_manager_send_parameter(rcp_manager* manager, int16_t id, bool metadata, void* client)
+{
+    return _send_parameters(manager, id, metadata, false, true, client);
+}
+
+/*
+ * send the current state of a parameter to one client
+ * recursive: with all descendants - else with the direct children of groups
+ * id 0: top level parameters
+ *
+ * no INITIALIZE - the client sees plain updates
+ * returns the number of parameters sent
+ */
+size_t rcp_manager_send_state(rcp_manager* manager, int16_t id, bool recursive, void* client)
+{
+    return _send_parameters(manager, id, false, recursive, false, client);
+}
+
+/*
+ * send the current state of count parameters to one client - without children
+ * ids without a parameter are skipped
+ *
+ * no INITIALIZE - the client sees plain updates
+ * returns the number of parameters sent
+ */
+size_t rcp_manager_send_state_list(rcp_manager* manager, const int16_t* ids, size_t count, void* client)
+{
+    if (manager == NULL) return 0;
+    if (manager->sendDataCbOne == NULL) return 0;
+
+    rcp_packet* packet = _begin_send_to_one(manager, client);
+    if (packet == NULL) return 0;
+
+    size_t sent = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        rcp_parameter* parameter = rcp_manager_get_parameter(manager, ids[i]);
+        if (parameter != NULL &&
+                _send_parameter(manager, packet, parameter, false) > 0)
+        {
+            sent++;
+        }
+    }
+
+    _end_send_to_one(manager, packet);
+
+    return sent;
+}
+
+size_t rcp_manager_get_pending_count(rcp_manager* manager)
+{
+    if (manager == NULL) return 0;
+
+    return manager->removed_count + manager->dirty_count;
+}
+
+void rcp_manager_set_clock_cb(rcp_manager* manager, uint64_t (*cb)(void* user))
+{
+    if (manager)
+    {
+        manager->clockCb = cb;
     }
 }
 
@@ -656,30 +2095,16 @@ rcp_group_parameter* rcp_manager_find_group(rcp_manager* manager, const char* na
 {
 	if (manager == NULL) return NULL;
     if (name == NULL) return NULL;
-	
-	rcp_parameter_list* list_item = manager->parameters;
-	
-	if (group != NULL)
-	{
-		list_item = rcp_group_get_children(group);
-	}
-	
-	// look through list
-    const char* label = NULL;
-	while (list_item != NULL)
-	{
-        label = rcp_parameter_get_label(list_item->parameter);
-		if (label != NULL &&
-                rcp_parameter_is_group(list_item->parameter) &&
-                strcmp(label, name) == 0)
-		{
-			return RCP_GROUP_PARAMETER(list_item->parameter);
-		}
-		list_item = list_item->next;
-	}
-	
-	// not found
-	return NULL;
+
+    rcp_parameter* found = _index_find(manager, rcp_parameter_get_id(RCP_PARAMETER(group)), name, strlen(name), true);
+    if (found != NULL ||
+            group != NULL)
+    {
+        return RCP_GROUP_PARAMETER(found);
+    }
+
+    // no group on top-level - any level
+    return RCP_GROUP_PARAMETER(_index_find_group(manager, name, strlen(name)));
 }
 
 rcp_parameter* rcp_manager_find_parameter(rcp_manager* manager, const char* name, rcp_group_parameter* group)
@@ -687,30 +2112,46 @@ rcp_parameter* rcp_manager_find_parameter(rcp_manager* manager, const char* name
     if (manager == NULL) return NULL;
     if (name == NULL) return NULL;
 
-	rcp_parameter_list* list_item = manager->parameters;
+    return _index_find(manager, rcp_parameter_get_id(RCP_PARAMETER(group)), name, strlen(name), false);
+}
+
+// find parameter by path of labels, e.g.: "mixer/ch12/gain"
+rcp_parameter* rcp_manager_find_path(rcp_manager* manager, const char* path)
+{
+    if (manager == NULL) return NULL;
+    if (path == NULL) return NULL;
 
-	if (group != NULL)
-	{
-		list_item = rcp_group_get_children(group);
-	}
+    rcp_parameter* parameter = NULL;
+    int16_t parent_id = 0;
 
-	// look through list
-    const char* label = NULL;
-	while (list_item != NULL)
-	{
-        if (rcp_parameter_get_parent(list_item->parameter) == group)
+    while (*path != 0)
+    {
+        if (*path == RCP_MANAGER_PATH_SEPARATOR)
         {
-            label = rcp_parameter_get_label(list_item->parameter);
-            if (label != NULL &&
-                    strcmp(label, name) == 0)
-            {
-                return list_item->parameter;
-            }
+            // skip separator
+            path++;
+            continue;
         }
 
-		list_item = list_item->next;
-	}
+        if (parameter != NULL &&
+                !rcp_parameter_is_group(parameter))
+        {
+            // path continues below a non-group parameter
+            return NULL;
+        }
+
+        const char* end = strchr(path, RCP_MANAGER_PATH_SEPARATOR);
+        size_t length = end != NULL ? (size_t)(end - path) : strlen(path);
+
+        parameter = _index_find(manager, parent_id, path, length, false);
+        if (parameter == NULL)
+        {
+            return NULL;
+        }
+
+        parent_id = rcp_parameter_get_id(parameter);
+        path += length;
+    }
 
-	// not found
-	return NULL;
+    return parameter;
 }
@@ -49,15 +49,20 @@ void rcp_manager_clear(rcp_manager* manager); // clear all parameters
 
 // parameter
 bool rcp_manager_add_parameter(rcp_manager* manager, rcp_parameter* parameter, bool is_server); // full transfer
-bool rcp_manager_update_parameter(rcp_manager* manager, rcp_parameter* parameter, bool is_server);
+bool rcp_manager_update_parameter(rcp_manager* manager, rcp_parameter* parameter, bool is_server); // full transfer if added, option data is taken otherwise
+const char* rcp_manager_apply_value_update(rcp_manager* manager, const char* data, size_t* size);
 rcp_parameter* rcp_manager_get_parameter(rcp_manager* manager, int16_t id);
 rcp_parameter_list* rcp_manager_get_paramter_list(rcp_manager* manager);
 void rcp_manager_set_dirty(rcp_manager* manager, rcp_parameter* parameter);
 bool rcp_manager_remove_parameter_id(rcp_manager* manager, int16_t parameter_id, bool is_server);
 
 // find
-rcp_group_parameter* rcp_manager_find_group(rcp_manager* manager, const char* name, rcp_group_parameter* group);
+rcp_group_parameter* rcp_manager_find_group(rcp_manager* manager, const char* name, rcp_group_parameter* group); // NULL: top level first, then any level
 rcp_parameter* rcp_manager_find_parameter(rcp_manager* manager, const char* name, rcp_group_parameter* group);
+rcp_parameter* rcp_manager_find_path(rcp_manager* manager, const char* path);
+
+// label or parent of parameter changed
+void rcp_manager_reindex_parameter(rcp_manager* manager, rcp_parameter* parameter);
 
 // callbacks
 void rcp_manager_set_parameter_added_cb(rcp_manager* manager, void (*cb)(rcp_parameter* parameter, void* user));
@@ -67,8 +72,35 @@ void rcp_manager_set_parameter_removed_cb(rcp_manager* manager, void (*cb)(rcp_p
 void rcp_manager_set_data_cb_one(rcp_manager* manager, void (*cb)(void*, const char*, size_t, void*));
 void rcp_manager_set_data_cb_all(rcp_manager* manager, void (*cb)(void*, const char*, size_t));
 
+// batch packets of one update into frames up to size bytes - 0: disabled (default)
+void rcp_manager_set_max_frame_size(rcp_manager* manager, size_t size);
+size_t rcp_manager_get_max_frame_size(rcp_manager* manager);
+
+// initial state and responses to one client in frames up to size bytes
+// 0: one packet per frame (default) - SIZE_MAX: all in one frame
+void rcp_manager_set_init_frame_size(rcp_manager* manager, size_t size);
+size_t rcp_manager_get_init_frame_size(rcp_manager* manager);
+
+// serialized state of all parameters for initializing clients - no transfer
+const char* rcp_manager_get_snapshot(rcp_manager* manager, size_t* size);
+size_t rcp_manager_send_snapshot(rcp_manager* manager, void* client); // returns bytes sent
+
+// send parameter and direct children of groups to one client - id 0: top level parameters
+size_t rcp_manager_send_parameter(rcp_manager* manager, int16_t id, bool metadata, void* client); // returns parameter count
+
+// send state of parameter and its children to one client - no end of response - id 0: top level parameters
+// recursive: all descendants - else direct children of groups
+size_t rcp_manager_send_state(rcp_manager* manager, int16_t id, bool recursive, void* client); // returns parameter count
+// send state of parameters of ids to one client - without children
+size_t rcp_manager_send_state_list(rcp_manager* manager, const int16_t* ids, size_t count, void* client); // returns parameter count
+
 // update
 void rcp_manager_update(rcp_manager* manager);
+size_t rcp_manager_update_budget(rcp_manager* manager, size_t max_bytes, uint64_t max_ns); // returns pending count
+size_t rcp_manager_get_pending_count(rcp_manager* manager);
+
+// clock used for budgets - monotonic time in nanoseconds
+void rcp_manager_set_clock_cb(rcp_manager* manager, uint64_t (*cb)(void* user));
 
 // logging
 void rcp_manager_log(rcp_manager* manager);
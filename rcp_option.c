@@ -73,7 +73,8 @@ typedef enum rcp_option_flags
     RCP_FLAG_OWNS_DATA = 0x02,
     RCP_FLAG_OWNS_PTR_DATA = RCP_FLAG_PTR_DATA | RCP_FLAG_OWNS_DATA,
     RCP_FLAG_DATA_CHANGED = 0x04,
-    RCP_FLAG_DATA_SIZE_PREFIXED = 0x08
+    RCP_FLAG_DATA_SIZE_PREFIXED = 0x08,
+    RCP_FLAG_DATA_BORROWED = 0x10 // string references parsed data - not zero-terminated
 } rcp_option_flags;
 
 union rcp_option_value
@@ -102,10 +103,12 @@ struct rcp_option
 
     union rcp_option_value data;
     size_t data_size; // size when serialized (this is not necessarily the size of the data)
+    size_t option_size; // cached size of serialized option including prefix - 0: not known
     rcp_option_data_type data_type;
     char prefix;
 
     unsigned char flags; // flags
+    bool in_arena; // node is released with its arena
 
 #ifdef RCP_OPTION_USE_EXTERNAL_GET_SET
     // external fetch func
@@ -115,32 +118,52 @@ struct rcp_option
 };
 
 
-// changed
-#define RCP_OPTION_SET_CHANGED(x) (x->flags |= RCP_FLAG_DATA_CHANGED)
+// changed - invalidates cached option size
+#define RCP_OPTION_SET_CHANGED(x) (x->flags |= RCP_FLAG_DATA_CHANGED, x->option_size = 0)
 #define RCP_OPTION_UNSET_CHANGED(x) (x->flags &= ~RCP_FLAG_DATA_CHANGED)
 #define RCP_OPTION_IS_CHANGED(x) (x->flags & RCP_FLAG_DATA_CHANGED)
 // ptr data
 #define RCP_OPTION_OWNS_DATA(x) (x->flags & RCP_FLAG_OWNS_DATA)
 #define RCP_OPTION_IS_PTR(x) (x->flags & RCP_FLAG_PTR_DATA)
+#define RCP_OPTION_IS_BORROWED(x) (x->flags & RCP_FLAG_DATA_BORROWED)
 
 
 rcp_option* rcp_option_create(char prefix)
+{
+    return rcp_option_create_in(prefix, NULL);
+}
+
+rcp_option* rcp_option_create_in(char prefix, rcp_arena* arena)
 {
     if (prefix == RCP_TERMINATOR) return NULL;
 
-    rcp_option* opt = (rcp_option*)RCP_CALLOC(1, sizeof(rcp_option));
+    rcp_option* opt = NULL;
+    if (arena != NULL)
+    {
+        opt = (rcp_option*)rcp_arena_calloc(arena, 1, sizeof(rcp_option));
+    }
+    else
+    {
+        opt = (rcp_option*)RCP_CALLOC(1, sizeof(rcp_option));
+    }
 
     if (opt)
     {
         RCP_OPTION_MALLOC_DEBUG("*** option [0x%02x]: %p\n", prefix, opt);
 
         opt->prefix = prefix;
+        opt->in_arena = arena != NULL;
     }
 
     return opt;
 }
 
 rcp_option* rcp_option_get_create(rcp_option** options, char prefix)
+{
+    return rcp_option_get_create_in(options, prefix, NULL);
+}
+
+rcp_option* rcp_option_get_create_in(rcp_option** options, char prefix, rcp_arena* arena)
 {
     if (options == NULL) return NULL;
 
@@ -150,7 +173,7 @@ rcp_option* rcp_option_get_create(rcp_option** options, char prefix)
 
     // no option with prefix
     // need to create option with prefix
-    opt = rcp_option_create(prefix);
+    opt = rcp_option_create_in(prefix, arena);
     if (opt != NULL)
     {
         opt->next = *options;
@@ -179,6 +202,34 @@ rcp_option* rcp_option_get(rcp_option* options, char prefix)
 }
 
 
+static bool _copy_string(rcp_option* opt, const char* data, size_t str_len, rcp_string_types type);
+
+static rcp_string_types _get_string_type(rcp_option* opt)
+{
+    switch (opt->data_type)
+    {
+    case RCP_SHORT_STRING:
+        return SHORT_STRING;
+    case RCP_LONG_STRING:
+        return LONG_STRING;
+    default:
+        return TINY_STRING;
+    }
+}
+
+// length of string data - borrowed strings are not zero-terminated
+static size_t _string_length(rcp_option* opt)
+{
+    if (opt->data.str == NULL) return 0;
+
+    if (RCP_OPTION_IS_BORROWED(opt))
+    {
+        return opt->data_size - _get_string_type(opt);
+    }
+
+    return strlen(opt->data.str);
+}
+
 static void _copy_option_data(rcp_option* dst, rcp_option* src)
 {
     if (dst == NULL) return;
@@ -195,15 +246,15 @@ static void _copy_option_data(rcp_option* dst, rcp_option* src)
 
     if (src->data_type == RCP_TINY_STRING)
     {
-        rcp_option_copy_string(dst, src->data.str, TINY_STRING);
+        _copy_string(dst, src->data.str, _string_length(src), TINY_STRING);
     }
     else if (src->data_type == RCP_SHORT_STRING)
     {
-        rcp_option_copy_string(dst, src->data.str, SHORT_STRING);
+        _copy_string(dst, src->data.str, _string_length(src), SHORT_STRING);
     }
     else if (src->data_type == RCP_LONG_STRING)
     {
-        rcp_option_copy_string(dst, src->data.str, LONG_STRING);
+        _copy_string(dst, src->data.str, _string_length(src), LONG_STRING);
     }
     else if (src->data_type == RCP_LANGUAGE_STRING)
     {
@@ -269,7 +320,45 @@ static void _copy_option_data(rcp_option* dst, rcp_option* src)
     }
 }
 
-rcp_option* rcp_option_add_or_update(rcp_option** options, rcp_option* src)
+static bool _can_move_data(rcp_option* src)
+{
+    // option data is never allocated from an arena
+    return RCP_OPTION_OWNS_DATA(src);
+}
+
+// take data from src - src is left without data
+static void _move_option_data(rcp_option* dst, rcp_option* src)
+{
+    if (dst == NULL) return;
+    if (src == NULL) return;
+    if (dst == src) return;
+
+    RCP_OPTION_DEBUG("%s\n", __FUNCTION__);
+
+    // free data - set changed
+    rcp_option_free_data(dst);
+
+    memcpy(&dst->data, &src->data, sizeof(union rcp_option_value));
+    dst->data_type = src->data_type;
+    dst->data_size = src->data_size;
+    dst->flags = src->flags;
+    RCP_OPTION_SET_CHANGED(dst);
+
+    if (dst->data_type == RCP_LANGUAGE_STRING)
+    {
+        // strings might reference parsed data
+        rcp_langstr_own_chain(dst->data.lng_str);
+    }
+
+    // src gives up its data
+    src->data.data = NULL;
+    src->data_type = RCP_NONE;
+    src->data_size = 0;
+    src->option_size = 0;
+    src->flags = RCP_FLAG_DATA_CHANGED;
+}
+
+static rcp_option* _add_or_update(rcp_option** options, rcp_option* src, bool move)
 {
     if (options == NULL) return NULL;
     if (src == NULL) return NULL;
@@ -288,7 +377,17 @@ rcp_option* rcp_option_add_or_update(rcp_option** options, rcp_option* src)
 
             RCP_OPTION_DEBUG("%s - updating option: %d\n", __FUNCTION__, opt->prefix);
 
-            if (RCP_OPTION_OWNS_DATA(src))
+            if (move
+                    && _can_move_data(src)
+#ifdef RCP_OPTION_USE_EXTERNAL_GET_SET
+                    && opt->externalSetCb == NULL
+#endif
+                    )
+            {
+                _move_option_data(opt, src);
+            }
+            else if (RCP_OPTION_OWNS_DATA(src)
+                    || RCP_OPTION_IS_BORROWED(src))
 			{
                 RCP_OPTION_DEBUG("src is owning the data! - opt owning %d\n", RCP_OPTION_OWNS_DATA(opt));
                 _copy_option_data(opt, src);
@@ -327,7 +426,8 @@ rcp_option* rcp_option_add_or_update(rcp_option** options, rcp_option* src)
     {
         RCP_OPTION_MALLOC_DEBUG("*** option own[0x%02x]: %p\n", src->prefix, new_opt);
 
-        if (RCP_OPTION_OWNS_DATA(src))
+        if (RCP_OPTION_OWNS_DATA(src)
+                || RCP_OPTION_IS_BORROWED(src))
         {
             new_opt->prefix = src->prefix;
             new_opt->data_size = src->data_size;
@@ -339,13 +439,22 @@ rcp_option* rcp_option_add_or_update(rcp_option** options, rcp_option* src)
             new_opt->externalSetCb = src->externalSetCb;
 #endif
 
-            // copy option data
-            _copy_option_data(new_opt, src);
+            if (move
+                    && _can_move_data(src))
+            {
+                _move_option_data(new_opt, src);
+            }
+            else
+            {
+                // copy option data
+                _copy_option_data(new_opt, src);
+            }
         }
         else
         {
             // copy option
             memcpy(new_opt, src, sizeof(rcp_option));
+            new_opt->in_arena = false;
         }
 
         // add option to chain
@@ -360,6 +469,17 @@ rcp_option* rcp_option_add_or_update(rcp_option** options, rcp_option* src)
     return NULL;
 }
 
+rcp_option* rcp_option_add_or_update(rcp_option** options, rcp_option* src)
+{
+    return _add_or_update(options, src, false);
+}
+
+// like rcp_option_add_or_update - takes owned data from src instead of copying it
+rcp_option* rcp_option_move_or_update(rcp_option** options, rcp_option* src)
+{
+    return _add_or_update(options, src, true);
+}
+
 
 void rcp_option_free_chain(rcp_option* opt)
 {
@@ -379,8 +499,11 @@ void rcp_option_free(rcp_option* opt)
     {
         rcp_option_free_data(opt);
 
-        RCP_OPTION_MALLOC_DEBUG("+++ option[0x%02x]: %p\n", opt->prefix, opt);
-        RCP_FREE(opt);
+        if (!opt->in_arena)
+        {
+            RCP_OPTION_MALLOC_DEBUG("+++ option[0x%02x]: %p\n", opt->prefix, opt);
+            RCP_FREE(opt);
+        }
     }
 }
 
@@ -389,6 +512,9 @@ void rcp_option_free_data(rcp_option* opt)
 {
     if (opt == NULL) return;
 
+    // data is about to change
+    opt->option_size = 0;
+
     if (opt->data_type != RCP_NONE)
     {
         if (RCP_OPTION_OWNS_DATA(opt))
@@ -468,6 +594,13 @@ void rcp_option_set_changed(rcp_option* opt, bool state)
 
 
 //
+bool rcp_option_has_data(rcp_option* opt)
+{
+    if (opt == NULL) return false;
+
+    return opt->data_type != RCP_NONE;
+}
+
 char rcp_option_get_prefix(rcp_option* opt)
 {
     if (opt == NULL) return 0;
@@ -527,7 +660,11 @@ size_t rcp_option_write_value(rcp_option* opt, char* data, size_t size)
     // copy data    
     if (RCP_OPTION_IS_PTR(opt))
     {
-        if (opt->data_type == RCP_TINY_STRING)
+        if (RCP_OPTION_IS_BORROWED(opt))
+        {
+            return rcp_write_string(data, size, opt->data.str, _string_length(opt), _get_string_type(opt));
+        }
+        else if (opt->data_type == RCP_TINY_STRING)
         {
             return rcp_write_tiny_string(data, size, opt->data.str);
         }
@@ -547,6 +684,12 @@ size_t rcp_option_write_value(rcp_option* opt, char* data, size_t size)
         {
             if (opt->flags & RCP_FLAG_DATA_SIZE_PREFIXED)
             {
+                if (size < opt->data_size + sizeof(uint32_t))
+                {
+                    RCP_OPTION_DEBUG("could not write data - buffer overflow\n");
+                    return 0;
+                }
+
                 // write length prefix
                 _rcp_store32(data, (uint32_t)opt->data_size);
 
@@ -557,6 +700,12 @@ size_t rcp_option_write_value(rcp_option* opt, char* data, size_t size)
             }
             else
             {
+                if (size < opt->data_size)
+                {
+                    RCP_OPTION_DEBUG("could not write data - buffer overflow\n");
+                    return 0;
+                }
+
                 // write data
                 memcpy((char*)data, opt->data.data, opt->data_size);
             }
@@ -577,27 +726,48 @@ size_t rcp_option_write_value(rcp_option* opt, char* data, size_t size)
     }
     else
     {
-        if (opt->data_size == 1)
-        {
-            memcpy(data, &opt->data.i8, 1);
-        }
-        else if (opt->data_size == 2)
-        {
-            _rcp_store16(data, (uint16_t)opt->data.i16);
-        }
-        else if (opt->data_size == 4)
-        {
-            _rcp_store32(data, (uint32_t)opt->data.i32);
-        }
-        else if (opt->data_size == 8)
-        {
-            _rcp_store64(data, (uint64_t)opt->data.i64);
-        }
-        else
+        size_t written = rcp_option_write_scalar(opt, data, size);
+        if (written == 0 &&
+                size >= opt->data_size)
         {
             RCP_ERROR("unsupported data_size: %d\n", opt->data_size);
-            return 0;
         }
+
+        return written;
+    }
+
+    return opt->data_size;
+}
+
+// store scalar value big-endian
+// returns 0 if this is no scalar value or it does not fit
+size_t rcp_option_write_scalar(rcp_option* opt, char* data, size_t size)
+{
+    if (opt == NULL) return 0;
+    if (RCP_OPTION_IS_PTR(opt)) return 0;
+
+    if (size < opt->data_size)
+    {
+        RCP_OPTION_DEBUG("could not write value - buffer overflow\n");
+        return 0;
+    }
+
+    switch (opt->data_size)
+    {
+    case 1:
+        memcpy(data, &opt->data.i8, 1);
+        break;
+    case 2:
+        _rcp_store16(data, (uint16_t)opt->data.i16);
+        break;
+    case 4:
+        _rcp_store32(data, (uint32_t)opt->data.i32);
+        break;
+    case 8:
+        _rcp_store64(data, (uint64_t)opt->data.i64);
+        break;
+    default:
+        return 0;
     }
 
     return opt->data_size;
@@ -895,7 +1065,8 @@ bool rcp_option_move_string(rcp_option* opt, const char* str, rcp_string_types t
             opt->data_type == RCP_LONG_STRING)
     {
         if (opt->data.str != NULL &&
-                strcmp(opt->data.str, str) == 0)
+                _string_length(opt) == strlen(str) &&
+                memcmp(opt->data.str, str, strlen(str)) == 0)
         {
             RCP_OPTION_UNSET_CHANGED(opt);
             return false;
@@ -914,11 +1085,39 @@ bool rcp_option_move_string(rcp_option* opt, const char* str, rcp_string_types t
     return true;
 }
 
+/* rcp_option_borrow_string
+ *  reference str_len characters of str:
+ *  str is not zero-terminated and needs to outlive the option data
+ */
+bool rcp_option_borrow_string(rcp_option* opt, const char* str, size_t str_len, rcp_string_types type)
+{
+    if (opt == NULL) return false;
+    if (str == NULL) return false;
+
+    // free data
+    rcp_option_free_data(opt);
+
+    opt->data.str = (char*)str;
+
+    _set_string_type(opt, type);
+    opt->data_size = type + str_len;
+    opt->flags |= RCP_FLAG_PTR_DATA | RCP_FLAG_DATA_BORROWED;
+    RCP_OPTION_SET_CHANGED(opt);
+    return true;
+}
+
 /* rcp_option_copy_string
  *  copy str into option:
  *  the option "owns" the data and attempts to free it on rcp_option_free()
  */
 bool rcp_option_copy_string(rcp_option* opt, const char* data, rcp_string_types type)
+{
+    if (data == NULL) return false;
+
+    return _copy_string(opt, data, strlen(data), type);
+}
+
+static bool _copy_string(rcp_option* opt, const char* data, size_t str_len, rcp_string_types type)
 {
     if (opt == NULL) return false;
     if (data == NULL) return false;
@@ -927,7 +1126,7 @@ bool rcp_option_copy_string(rcp_option* opt, const char* data, rcp_string_types
     if (opt->externalSetCb != NULL)
     {
         // use external set
-        bool result = opt->externalSetCb((void*)data, strlen(data));
+        bool result = opt->externalSetCb((void*)data, str_len);
 
         _set_string_type(opt, type);
 
@@ -942,7 +1141,8 @@ bool rcp_option_copy_string(rcp_option* opt, const char* data, rcp_string_types
             opt->data_type == RCP_LONG_STRING)
     {
         if (opt->data.str != NULL &&
-                strcmp(opt->data.str, data) == 0)
+                _string_length(opt) == str_len &&
+                memcmp(opt->data.str, data, str_len) == 0)
         {
             RCP_OPTION_UNSET_CHANGED(opt);
             return false;
@@ -953,8 +1153,6 @@ bool rcp_option_copy_string(rcp_option* opt, const char* data, rcp_string_types
     // free data
     rcp_option_free_data(opt);
 
-    // get length of string to copy
-    size_t str_len = strlen(data);
     if (str_len > 0)
     {
         // try to alloc memory
@@ -965,7 +1163,7 @@ bool rcp_option_copy_string(rcp_option* opt, const char* data, rcp_string_types
             RCP_OPTION_MALLOC_DEBUG("*** string: %p\n", opt->data.str);
 
             // copy string
-            strncpy(opt->data.str, data, str_len);
+            memcpy(opt->data.str, data, str_len);
 
             RCP_OPTION_SET_CHANGED(opt);
         }
@@ -1057,8 +1255,8 @@ bool rcp_option_copy_any_language(rcp_option* opt, const char* str, rcp_string_t
     // copy text
     rcp_langstr_copy_string(lng_str, str, type);
 
-    // update size
-    opt->data_size = rcp_langstr_get_chain_size(lng_str);
+    // update size of whole chain
+    opt->data_size = rcp_langstr_get_chain_size(opt->data.lng_str);
 
     RCP_OPTION_SET_CHANGED(opt);
     return true;
@@ -1174,10 +1372,26 @@ const char* rcp_option_get_string(rcp_option* opt, rcp_string_types type)
     }
 #endif
 
+    // borrowed strings are not zero-terminated
+    if (RCP_OPTION_IS_BORROWED(opt)) return NULL;
+
     // return str
     return opt->data.str;
 }
 
+// string and its length - not necessarily zero-terminated
+const char* rcp_option_get_string_view(rcp_option* opt, rcp_string_types type, size_t* length)
+{
+    if (length != NULL) *length = 0;
+    if (opt == NULL) return NULL;
+    if (type == TINY_STRING && opt->data_type != RCP_TINY_STRING) return NULL;
+    if (type == SHORT_STRING && opt->data_type != RCP_SHORT_STRING) return NULL;
+    if (type == LONG_STRING && opt->data_type != RCP_LONG_STRING) return NULL;
+
+    if (length != NULL) *length = _string_length(opt);
+    return opt->data.str;
+}
+
 rcp_language_str* rcp_option_get_langstr(rcp_option* opt)
 {
     if (opt == NULL) return NULL;
@@ -1394,7 +1608,7 @@ void rcp_option_log(rcp_option* opt, const char* prefix_str, bool isunsigned)
     case RCP_TINY_STRING:
     case RCP_SHORT_STRING:
     case RCP_LONG_STRING:
-        RCP_INFO("\toption: 0x%02x - %s: %s\n", opt->prefix, prefix_str != NULL ? prefix_str : "", opt->data.str);
+        RCP_INFO("\toption: 0x%02x - %s: %.*s\n", opt->prefix, prefix_str != NULL ? prefix_str : "", (int)_string_length(opt), opt->data.str);
         break;
     case RCP_LANGUAGE_STRING:
         rcp_langstr_log_chain(opt->data.lng_str);
@@ -1435,16 +1649,24 @@ size_t rcp_option_get_size(rcp_option* opt, bool force)
     if (opt == NULL) return 0;
     if (!force && !RCP_OPTION_IS_CHANGED(opt)) return 0;
 
+    if (opt->option_size > 0)
+    {
+        return opt->option_size;
+    }
+
     size_t size = 1; // prefix
 
     // ask option datatypes which might have changed
+    // these sizes are not cached
     if (opt->data_type == RCP_PARAMETER_DATA)
     {
         size += rcp_parameter_get_size(opt->data.parameter_data, force);
+        return size;
     }
     else if (opt->data_type == RCP_INFO_DATA)
     {
         size += rcp_infodata_get_size(opt->data.info_data);
+        return size;
     }
 #ifdef RCP_OPTION_USE_EXTERNAL_GET_SET
     else if (opt->externalGetCb != NULL)
@@ -1470,6 +1692,9 @@ size_t rcp_option_get_size(rcp_option* opt, bool force)
         {
             size += ext_size;
         }
+
+        // external data might change any time
+        return size;
     }
 #endif
     else
@@ -1480,6 +1705,8 @@ size_t rcp_option_get_size(rcp_option* opt, bool force)
         {
             size += sizeof(uint32_t);
         }
+
+        opt->option_size = size;
     }
 
     RCP_OPTION_DEBUG("option size [0x%02x]: %lu\n", opt->prefix, size);
@@ -1594,7 +1821,8 @@ size_t rcp_option_write(rcp_option* opt, char* data, size_t size, bool force)
     }
 #endif
 
-    RCP_OPTION_UNSET_CHANGED(opt);
+    // NOTE: changed flag is cleared by the packet after a complete write
+    // a write which runs out of space must not lose changes
 
     return written;
 }
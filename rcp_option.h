@@ -36,6 +36,7 @@ extern "C"{
 #include "rcp_langstr.h"
 #include "rcp_infodata.h"
 #include "rcp_stringlist.h"
+#include "rcp_arena.h"
 
 //#define RCP_OPTION_DEBUG_LOG
 //#define RCP_OPTION_MALLOC_DEBUG_LOG
@@ -44,8 +45,12 @@ extern "C"{
 // create / free
 rcp_option* rcp_option_create(char prefix);
 rcp_option* rcp_option_get_create(rcp_option** options, char prefix);
+// option node is allocated from arena (NULL: heap) - option data is not
+rcp_option* rcp_option_create_in(char prefix, rcp_arena* arena);
+rcp_option* rcp_option_get_create_in(rcp_option** options, char prefix, rcp_arena* arena);
 rcp_option* rcp_option_get(rcp_option* options, char prefix);
 rcp_option* rcp_option_add_or_update(rcp_option** options, rcp_option* new_option);
+rcp_option* rcp_option_move_or_update(rcp_option** options, rcp_option* new_option); // takes owned data from new_option
 void rcp_option_free(rcp_option* opt);
 void rcp_option_free_chain(rcp_option* opt);
 void rcp_option_free_data(rcp_option* opt);
@@ -60,6 +65,9 @@ void rcp_option_set_changed(rcp_option* opt, bool state);
 // prefix
 char rcp_option_get_prefix(rcp_option* opt);
 
+// false if no data is set (e.g. after rcp_option_free_data)
+bool rcp_option_has_data(rcp_option* opt);
+
 // setter / getter
 bool rcp_option_set_bool(rcp_option* opt, bool value);
 bool rcp_option_set_i8(rcp_option* opt, int8_t value);
@@ -93,7 +101,9 @@ float rcp_option_get_vector2f_y(rcp_option* opt);
 // string
 bool rcp_option_move_string(rcp_option* opt, const char* data, rcp_string_types type); // full transfer
 bool rcp_option_copy_string(rcp_option* opt, const char* data, rcp_string_types type); // copies string, full transfer
-const char* rcp_option_get_string(rcp_option* opt, rcp_string_types type); // no transfer
+bool rcp_option_borrow_string(rcp_option* opt, const char* str, size_t str_len, rcp_string_types type); // no transfer, not zero-terminated
+const char* rcp_option_get_string(rcp_option* opt, rcp_string_types type); // no transfer, NULL if borrowed
+const char* rcp_option_get_string_view(rcp_option* opt, rcp_string_types type, size_t* length); // no transfer, not zero-terminated if borrowed
 
 // language string
 bool rcp_option_move_langstr(rcp_option* opt, rcp_language_str* data); // full transfer
@@ -122,6 +132,8 @@ size_t rcp_option_get_size(rcp_option* opt, bool force);
 size_t rcp_option_write(rcp_option* opt, char* dst, size_t size, bool force);
 // write value into data, return size
 size_t rcp_option_write_value(rcp_option* opt, char* dst, size_t size);
+// write scalar value into data, return size or 0 if not a scalar
+size_t rcp_option_write_scalar(rcp_option* opt, char* dst, size_t size);
 // get size of data
 size_t rcp_option_get_data_size(rcp_option* opt);
 
@@ -28,6 +28,7 @@
 
 #include "rcp_memory.h"
 #include "rcp_logging.h"
+#include "rcp_endian.h"
 #include "rcp_parser.h"
 #include "rcp_option.h"
 #include "rcp_parameter.h"
@@ -54,6 +55,12 @@ struct rcp_packet
 
     // options
     rcp_option* options;
+
+    // memory of parsed parameters - NULL: heap
+    rcp_arena* arena;
+
+    // strings of parsed parameters reference the parsed data
+    bool borrow_strings;
 };
 
 rcp_packet* rcp_packet_create(rcp_packet_command command)
@@ -94,6 +101,43 @@ void rcp_packet_free(rcp_packet* packet)
     RCP_FREE(packet);
 }
 
+// reset packet for reuse
+// frees option data but keeps the option nodes
+void rcp_packet_reset(rcp_packet* packet, rcp_packet_command command)
+{
+    if (packet == NULL) return;
+
+    packet->command = command;
+
+    rcp_option* opt = packet->options;
+    while (opt)
+    {
+        // frees owned parameter and infodata
+        rcp_option_free_data(opt);
+        rcp_option_set_changed(opt, false);
+
+        opt = rcp_option_get_next(opt);
+    }
+}
+
+// parameters parsed into packet are allocated from arena
+// they are released with the arena - a taken parameter must not outlive it
+void rcp_packet_set_arena(rcp_packet* packet, rcp_arena* arena)
+{
+    if (packet == NULL) return;
+
+    packet->arena = arena;
+}
+
+// strings of parameters parsed into packet reference the parsed data
+// the data has to outlive the parameter
+void rcp_packet_set_borrow_strings(rcp_packet* packet, bool borrow)
+{
+    if (packet == NULL) return;
+
+    packet->borrow_strings = borrow;
+}
+
 void rcp_packet_set_command(rcp_packet* packet, rcp_packet_command command)
 {
     if (packet == NULL) return;
@@ -280,6 +324,19 @@ void rcp_packet_log(rcp_packet* packet)
 #endif
 }
 
+// free packet after parsing error - a reused packet is only reset
+static void _discard_packet(rcp_packet* packet, rcp_packet** out_packet)
+{
+    if (packet == *out_packet)
+    {
+        rcp_packet_reset(packet, COMMAND_INVALID);
+    }
+    else
+    {
+        rcp_packet_free(packet);
+    }
+}
+
 /**
 * rcp_parse_packet
 *   parse data to construct a rcp-packet
@@ -289,6 +346,7 @@ void rcp_packet_log(rcp_packet* packet)
 *   available data to read from
 * out_packet
 *   the resulting packet, if any
+*   a packet passed in (*out_packet != NULL) is reset and reused
 * out_size
 *   data size of data returned by this function
 *
@@ -305,11 +363,6 @@ const char* rcp_packet_parse(const char* data, size_t size, rcp_packet** out_pac
         return NULL;
     }
 
-    if (*out_packet != NULL)
-    {
-        RCP_PACKET_DEBUG("potential memory leak - out_packet != NULL");
-    }
-
     rcp_packet* packet = NULL;
     rcp_packet_command command = 0;
     uint8_t option_prefix = 0;
@@ -317,24 +370,32 @@ const char* rcp_packet_parse(const char* data, size_t size, rcp_packet** out_pac
     data = rcp_read_i8(data, &size, (int8_t*)&command);
     if (data == NULL) return NULL;
 
-    if (command == COMMAND_INVALID
-            || command >= COMMAND_MAX_)
+    if (!RCP_COMMAND_VALID(command))
     {
         RCP_ERROR("invalid command: %d\n", command);
         return NULL;
     }
 
-    packet = rcp_packet_create(command);
-    if (packet == NULL)
+    if (*out_packet != NULL)
     {
-        RCP_ERROR("could not create packet\n");
-        return NULL;
+        // reuse packet
+        packet = *out_packet;
+        rcp_packet_reset(packet, command);
+    }
+    else
+    {
+        packet = rcp_packet_create(command);
+        if (packet == NULL)
+        {
+            RCP_ERROR("could not create packet\n");
+            return NULL;
+        }
     }
 
     if (command == COMMAND_UPDATEVALUE)
     {
         // handle update value command
-        rcp_parameter* parameter = rcp_parse_value_update(&data, &size);
+        rcp_parameter* parameter = rcp_parse_value_update(&data, &size, packet->arena, packet->borrow_strings);
         if (parameter)
         {
             // NOTE: ownership is transfered
@@ -349,7 +410,7 @@ const char* rcp_packet_parse(const char* data, size_t size, rcp_packet** out_pac
         else
         {
             RCP_PACKET_DEBUG("could not parse parameter (updatevalue)\n");
-            rcp_packet_free(packet);
+            _discard_packet(packet, out_packet);
             return NULL;
         }
     }
@@ -360,7 +421,7 @@ const char* rcp_packet_parse(const char* data, size_t size, rcp_packet** out_pac
         data = rcp_read_u8(data, &size, &option_prefix);
         if (data == NULL)
         {
-            rcp_packet_free(packet);
+            _discard_packet(packet, out_packet);
             return NULL;
         }
 
@@ -385,7 +446,7 @@ const char* rcp_packet_parse(const char* data, size_t size, rcp_packet** out_pac
             data = rcp_read_i64(data, &size, &val);
             if (data == NULL)
             {
-                rcp_packet_free(packet);
+                _discard_packet(packet, out_packet);
                 return NULL;
             }
 
@@ -400,13 +461,15 @@ const char* rcp_packet_parse(const char* data, size_t size, rcp_packet** out_pac
             case COMMAND_INITIALIZE:
             case COMMAND_DISCOVER:
             case COMMAND_REMOVE:
+            case COMMAND_SUBSCRIBE:
+            case COMMAND_UNSUBSCRIBE:
             {
                 // id-data
                 int16_t id = 0;
                 data = rcp_read_i16(data, &size, &id);
                 if (data == NULL)
                 {
-                    rcp_packet_free(packet);
+                    _discard_packet(packet, out_packet);
                     return NULL;
                 }
 
@@ -427,7 +490,7 @@ const char* rcp_packet_parse(const char* data, size_t size, rcp_packet** out_pac
                 {
                     // parsing error
                     RCP_PACKET_DEBUG("could not parse infodata\n");
-                    rcp_packet_free(packet);
+                    _discard_packet(packet, out_packet);
                     return NULL;
                 }
                 break;
@@ -436,7 +499,7 @@ const char* rcp_packet_parse(const char* data, size_t size, rcp_packet** out_pac
             case COMMAND_UPDATE:            
             {
                 // expect parameter
-                rcp_parameter* parameter = rcp_parse_parameter(&data, &size);
+                rcp_parameter* parameter = rcp_parse_parameter(&data, &size, packet->arena, packet->borrow_strings);
 
                 if (parameter)
                 {
@@ -448,7 +511,7 @@ const char* rcp_packet_parse(const char* data, size_t size, rcp_packet** out_pac
                 {
                     // parsing error
                     RCP_PACKET_DEBUG("could not parse parameter\n");
-                    rcp_packet_free(packet);
+                    _discard_packet(packet, out_packet);
                     return NULL;
                 }
                 break;
@@ -468,12 +531,56 @@ const char* rcp_packet_parse(const char* data, size_t size, rcp_packet** out_pac
 
     // parsing error
     RCP_PACKET_DEBUG("packet parsing error\n");
-    rcp_packet_free(packet);
+    _discard_packet(packet, out_packet);
     return NULL;
 }
 
 
-static size_t _packet_size(rcp_packet* packet, bool all)
+// get parameter id of UPDATE and UPDATEVALUE packet without parsing it
+// returns 0 for other packets or if not enough data
+int16_t rcp_packet_peek_parameter_id(const char* data, size_t size)
+{
+    if (data == NULL) return 0;
+    if (size < 1) return 0;
+
+    int16_t id = 0;
+    size_t offset = 1;
+
+    if (data[0] == COMMAND_UPDATEVALUE)
+    {
+        if (size < offset + 2) return 0;
+
+        _rcp_load16(int16_t, data + offset, &id);
+        return id;
+    }
+
+    if (data[0] != COMMAND_UPDATE) return 0;
+
+    while (offset < size)
+    {
+        if (data[offset] == PACKET_OPTIONS_TIMESTAMP)
+        {
+            // prefix + int64
+            offset += 9;
+        }
+        else if (data[offset] == PACKET_OPTIONS_DATA)
+        {
+            if (size < offset + 3) return 0;
+
+            _rcp_load16(int16_t, data + offset + 1, &id);
+            return id;
+        }
+        else
+        {
+            return 0;
+        }
+    }
+
+    return 0;
+}
+
+// serialized size of packet
+size_t rcp_packet_get_size(rcp_packet* packet, bool all)
 {
     if (packet == NULL) return 0;
 
@@ -504,59 +611,69 @@ static size_t _packet_size(rcp_packet* packet, bool all)
     rcp_option* opt = packet->options;
     while (opt)
     {
-        size += rcp_option_get_size(opt, all);
+        if (rcp_option_has_data(opt))
+        {
+            size += rcp_option_get_size(opt, all);
+        }
         opt = rcp_option_get_next(opt);
     }
 
     return size;
 }
 
-// write into buffer
-// returns bytes written
-size_t rcp_packet_write_buf(rcp_packet* packet, char* data, size_t size, bool all)
+// clear changed flags of everything written
+static void _packet_written(rcp_packet* packet)
 {
-    if (packet == NULL ||
-            data == NULL)
+    rcp_option* opt = packet->options;
+    while (opt)
     {
-        return 0;
-    }
+        rcp_option_set_changed(opt, false);
+
+        // NOTE: returns NULL for other option data
+        rcp_parameter_all_options_unchanged(rcp_option_get_parameter(opt));
 
-    size_t packet_size = _packet_size(packet, all);
+        opt = rcp_option_get_next(opt);
+    }
+}
 
-    if (size < packet_size)
+// write into buffer in one pass
+// returns bytes written
+// returns 0 on error or if the packet does not fit - nothing is marked unchanged in that case
+// use rcp_packet_get_size to get the needed size
+size_t rcp_packet_write_buf(rcp_packet* packet, char* data, size_t size, bool all)
+{
+    if (packet == NULL ||
+            data == NULL ||
+            size == 0)
     {
-        RCP_PACKET_DEBUG("destination buffer not big enough\n");
         return 0;
     }
 
     size_t written = 0;
     size_t written_len = 0;
 
-    // write commanad
-    *data = packet->command;
-    written += 1;
-    data += 1;
-
-
     if (packet->command == COMMAND_UPDATEVALUE)
     {
+        // header is cached in parameter
         rcp_parameter* parameter = rcp_packet_get_parameter(packet);
-        written_len = rcp_parameter_write_updatevalue(parameter, data, size - written);
-        if (written_len == 0)
-        {
-            return 0;
-        }
+        written_len = rcp_parameter_write_updatevalue_packet(parameter, data, size);
 
         RCP_PACKET_DEBUG("written update value bytes: %d\n", written_len);
-        return written + written_len;
+        return written_len;
     }
 
+    // write commanad
+    *data = packet->command;
+    written += 1;
+    data += 1;
+
 
     // write all options
     rcp_option* opt = packet->options;
     while (opt)
     {
-        if (all || rcp_option_is_changed(opt))
+        if (rcp_option_has_data(opt)
+                && (all || rcp_option_is_changed(opt)))
         {
             written_len = rcp_option_write(opt, data, size - written, all);
             RCP_PACKET_DEBUG("packet options - written len: %d\n", written_len);
@@ -565,23 +682,99 @@ size_t rcp_packet_write_buf(rcp_packet* packet, char* data, size_t size, bool al
                 return 0;
             }
 
-            if (written_len)
-            {
-                written += written_len;
-                data += written_len;
-            }
+            written += written_len;
+            data += written_len;
         }
 
         opt = rcp_option_get_next(opt);
     }
 
     // write terminator
+    if (written >= size)
+    {
+        RCP_PACKET_DEBUG("destination buffer not big enough\n");
+        return 0;
+    }
+
     *data = RCP_TERMINATOR;
     written += 1;
 
+    if (!all)
+    {
+        _packet_written(packet);
+    }
+
     return written;
 }
 
+// make sure buffer can hold size bytes
+bool rcp_packet_reserve_buffer(char** buffer, size_t* buffer_size, size_t size)
+{
+    if (size <= *buffer_size) return true;
+
+    size_t new_size = *buffer_size > 0 ? *buffer_size : RCP_PACKET_WRITE_BUFFER_SIZE;
+    while (new_size < size)
+    {
+        new_size *= 2;
+    }
+
+    char* new_buffer = (char*)RCP_REALLOC(*buffer, new_size);
+    if (new_buffer == NULL)
+    {
+        RCP_ERROR("could not grow write buffer\n");
+        return false;
+    }
+
+    RCP_PACKET_MALLOC_DEBUG("*** write buffer: %p (%d)\n", new_buffer, new_size);
+
+    *buffer = new_buffer;
+    *buffer_size = new_size;
+
+    return true;
+}
+
+// write into buffer at offset, growing the buffer if needed
+// *buffer may be NULL, use RCP_FREE() to release it
+// the size is only computed if the packet did not fit
+// returns the number of bytes written
+size_t rcp_packet_write_grow(rcp_packet* packet, char** buffer, size_t* buffer_size, size_t offset, bool all)
+{
+    if (packet == NULL) return 0;
+    if (buffer == NULL) return 0;
+    if (buffer_size == NULL) return 0;
+
+    if (*buffer == NULL)
+    {
+        *buffer_size = 0;
+    }
+
+    if (!rcp_packet_reserve_buffer(buffer, buffer_size, offset + RCP_PACKET_WRITE_BUFFER_SIZE))
+    {
+        return 0;
+    }
+
+    size_t written = rcp_packet_write_buf(packet, *buffer + offset, *buffer_size - offset, all);
+    if (written > 0)
+    {
+        return written;
+    }
+
+    // did not fit?
+    size_t packet_size = rcp_packet_get_size(packet, all);
+    if (offset + packet_size <= *buffer_size)
+    {
+        RCP_PACKET_DEBUG("could not write packet\n");
+        return 0;
+    }
+
+    if (!rcp_packet_reserve_buffer(buffer, buffer_size, offset + packet_size))
+    {
+        return 0;
+    }
+
+    return rcp_packet_write_buf(packet, *buffer + offset, *buffer_size - offset, all);
+}
+
 // dynamically allocates destination buffer
 // use RCP_FREE() to release *dst
 // otherwise a memory leak will be reported if RCP_MEM_CHECK is defined (see rcp_memory.h)
@@ -599,23 +792,12 @@ size_t rcp_packet_write(rcp_packet* packet, char** dst, bool all)
         RCP_PACKET_DEBUG("potential memory leak - *dst != NULL\n");
     }
 
+    *dst = NULL;
+    size_t dst_size = 0;
 
-    // get serialized size
-    size_t packet_data_size = _packet_size(packet, all);
-    RCP_PACKET_DEBUG("packet size: %d\n", packet_data_size);
-
-    // alloc memory
-    *dst = RCP_CALLOC(1, packet_data_size);
-    if (*dst == NULL)
-    {
-        RCP_ERROR("could not allocate for serialize data\n");
-        return 0;
-    }
-
-    RCP_PACKET_MALLOC_DEBUG("*** data output: %p\n", *dst);
-
-    size_t written = rcp_packet_write_buf(packet, *dst, packet_data_size, all);
-    if (written == 0)
+    size_t written = rcp_packet_write_grow(packet, dst, &dst_size, 0, all);
+    if (written == 0 &&
+            *dst != NULL)
     {
         // free data
         RCP_PACKET_MALLOC_DEBUG("+++ data output: %p\n", *dst);
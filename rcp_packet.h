@@ -34,13 +34,20 @@ extern "C"{
 #include "rcp_option_type.h"
 #include "rcp_parameter_type.h"
 #include "rcp_infodata.h"
+#include "rcp_arena.h"
 
 //#define RCP_PACKET_DEBUG_LOG
 //#define RCP_PACKET_MALLOC_DEBUG_LOG
 
+// minimum free space when writing into a growable buffer
+#ifndef RCP_PACKET_WRITE_BUFFER_SIZE
+#define RCP_PACKET_WRITE_BUFFER_SIZE 64
+#endif
+
 // create / free
 rcp_packet* rcp_packet_create(rcp_packet_command command);
 void rcp_packet_free(rcp_packet* packet);
+void rcp_packet_reset(rcp_packet* packet, rcp_packet_command command); // reuse, keeps option nodes
 
 // command
 void rcp_packet_set_command(rcp_packet* packet, rcp_packet_command command);
@@ -66,10 +73,20 @@ rcp_parameter* rcp_packet_get_parameter(rcp_packet* packet); // no transfer
 void rcp_packet_put_parameter(rcp_packet* packet, rcp_parameter* parameter); // full transfer
 rcp_parameter* rcp_packet_take_parameter(rcp_packet* packet); // full transfer
 
+// parse parameters into arena - NULL: heap
+// parameters parsed into an arena must not outlive the next rcp_arena_reset
+void rcp_packet_set_arena(rcp_packet* packet, rcp_arena* arena);
+// reference strings in parsed data instead of copying them - data has to outlive the parameter
+void rcp_packet_set_borrow_strings(rcp_packet* packet, bool borrow);
+
 // parse and write
 const char* rcp_packet_parse(const char* data, size_t size, rcp_packet** out_packet, size_t* out_size);
+int16_t rcp_packet_peek_parameter_id(const char* data, size_t size);
+size_t rcp_packet_get_size(rcp_packet* packet, bool all);
 size_t rcp_packet_write(rcp_packet* packet, char** dst, bool all);
-size_t rcp_packet_write_buf(rcp_packet* packet, char* data, size_t size, bool all);
+size_t rcp_packet_write_buf(rcp_packet* packet, char* data, size_t size, bool all); // 0 if it does not fit
+size_t rcp_packet_write_grow(rcp_packet* packet, char** buffer, size_t* buffer_size, size_t offset, bool all);
+bool rcp_packet_reserve_buffer(char** buffer, size_t* buffer_size, size_t size); // grow a write buffer to hold size bytes
 
 void rcp_packet_log(rcp_packet* packet);
 
@@ -67,6 +67,25 @@ struct rcp_parameter
     void (*optionUpdatedCb)(rcp_parameter*, void* user);
     rcp_manager* manager;
     rcp_group_parameter* parent;
+
+    // entry in children list of parent
+    rcp_parameter_list child_entry;
+
+    // entry in dirty queue of manager
+    rcp_parameter_list dirty_entry;
+    bool queued;
+    bool throttled; // dirty entry is in rate limited list
+
+    // send rate limit
+    uint32_t send_interval; // ms, 0: no limit
+    uint64_t last_sent; // ns
+
+    // cached UPDATEVALUE header - 0: not built yet
+    char value_header[4];
+    uint8_t value_header_size;
+
+    // memory of parsed parameter and its option nodes - NULL: heap
+    rcp_arena* arena;
 	
 	void* user;
 };
@@ -95,7 +114,17 @@ struct rcp_value_parameter
 
 
 
-static rcp_value_parameter* _create_value_parameter(int16_t id, rcp_datatype typeid)
+static void* _alloc(rcp_arena* arena, size_t size)
+{
+    if (arena != NULL)
+    {
+        return rcp_arena_calloc(arena, 1, size);
+    }
+
+    return RCP_CALLOC(1, size);
+}
+
+static rcp_parameter* _create_parameter(int16_t id, rcp_datatype typeid, size_t size, rcp_arena* arena)
 {
     if (id == 0)
     {
@@ -103,19 +132,31 @@ static rcp_value_parameter* _create_value_parameter(int16_t id, rcp_datatype typ
         return NULL;
     }
 
-    rcp_value_parameter* parameter = (rcp_value_parameter*)RCP_CALLOC(1, sizeof(rcp_value_parameter));
+    rcp_parameter* parameter = (rcp_parameter*)_alloc(arena, size);
 
     if (parameter)
     {
         RCP_PARAMETER_MALLOC_DEBUG("*** param: %p\n", parameter);
 
-        RCP_PARAMETER(parameter)->typedefinition = rcp_typedefinition_create(typeid);
-        RCP_PARAMETER(parameter)->id = id;
+        parameter->typedefinition = rcp_typedefinition_create_in(typeid, arena);
+        parameter->id = id;
+        parameter->arena = arena;
     }
 
     return parameter;
 }
 
+// option nodes of parsed parameters live in their arena
+static rcp_option* _get_create_option(rcp_parameter* parameter, char prefix)
+{
+    return rcp_option_get_create_in(&parameter->options, prefix, parameter->arena);
+}
+
+static rcp_value_parameter* _create_value_parameter(int16_t id, rcp_datatype typeid)
+{
+    return RCP_VALUE_PARAMETER(_create_parameter(id, typeid, sizeof(rcp_value_parameter), NULL));
+}
+
 static inline bool is_value_type(rcp_datatype type)
 {
     return type != DATATYPE_INVALID &&
@@ -190,20 +231,7 @@ rcp_value_parameter* rcp_ipv4_parameter_create(int16_t id)
 
 rcp_bang_parameter* rcp_bang_parameter_create(int16_t id)
 {
-    if (id == 0) return NULL;
-
-    rcp_bang_parameter* parameter = (rcp_bang_parameter*)RCP_CALLOC(1, sizeof(rcp_bang_parameter));
-
-    if (parameter)
-    {
-        RCP_PARAMETER_MALLOC_DEBUG("*** param: %p\n", parameter);
-
-        // create typedef
-        parameter->parameter_base.typedefinition = rcp_typedefinition_create(DATATYPE_BANG);
-        parameter->parameter_base.id = id;
-    }
-
-    return parameter;
+    return RCP_BANG_PARAMETER(_create_parameter(id, DATATYPE_BANG, sizeof(rcp_bang_parameter), NULL));
 }
 
 rcp_value_parameter* rcp_custom_parameter_create(int16_t id, uint32_t size)
@@ -221,20 +249,38 @@ rcp_value_parameter* rcp_custom_parameter_create(int16_t id, uint32_t size)
 
 rcp_group_parameter* rcp_group_parameter_create(int16_t id)
 {
-    if (id == 0) return NULL;
-
-    rcp_group_parameter* parameter = (rcp_group_parameter*)RCP_CALLOC(1, sizeof(rcp_group_parameter));
-
-    if (parameter)
-    {
-        RCP_PARAMETER_MALLOC_DEBUG("*** param: %p\n", parameter);
-
-        // create typedef
-        RCP_PARAMETER(parameter)->typedefinition = rcp_typedefinition_create(DATATYPE_GROUP);
-        RCP_PARAMETER(parameter)->id = id;
-    }
-
-    return parameter;
+    return RCP_GROUP_PARAMETER(_create_parameter(id, DATATYPE_GROUP, sizeof(rcp_group_parameter), NULL));
+}
+
+// create parameter of type - used by the parser
+rcp_parameter* rcp_parameter_create_in(int16_t id, rcp_datatype type, rcp_arena* arena)
+{
+    switch (type)
+    {
+    case DATATYPE_BANG:
+        return _create_parameter(id, type, sizeof(rcp_bang_parameter), arena);
+    case DATATYPE_GROUP:
+        return _create_parameter(id, type, sizeof(rcp_group_parameter), arena);
+    case DATATYPE_BOOLEAN:
+    case DATATYPE_INT8:
+    case DATATYPE_UINT8:
+    case DATATYPE_INT16:
+    case DATATYPE_UINT16:
+    case DATATYPE_INT32:
+    case DATATYPE_UINT32:
+    case DATATYPE_FLOAT32:
+    case DATATYPE_VECTOR2F32:
+    case DATATYPE_STRING:
+    case DATATYPE_ENUM:
+    case DATATYPE_IPV4:
+    case DATATYPE_CUSTOMTYPE:
+        return _create_parameter(id, type, sizeof(rcp_value_parameter), arena);
+    default:
+        break;
+    }
+
+    RCP_DEBUG("type id not implemented: %d\n", type);
+    return NULL;
 }
 
 
@@ -253,18 +299,26 @@ static void free_group_parameter(rcp_group_parameter* group)
 
         // INFO: don't free children here! (just cleanup the list)
         // parameters are either manager in the manager or have to be freed manually
-
-        RCP_PARAMETER_MALLOC_DEBUG("+++ children list item: %p\n", list);
-        RCP_FREE(list);
+        list->parameter->parent = NULL;
+        list->parameter = NULL;
+        list->next = NULL;
+        list->prev = NULL;
 
         list = next;
     }
+
+    group->children = NULL;
 }
 
+static void _remove_from_parent(rcp_parameter* parameter);
+
 void rcp_parameter_free(rcp_parameter* parameter)
 {
     if (parameter == NULL) return;
 
+    // remove from children of parent
+    _remove_from_parent(parameter);
+
     // before freeing base parameter, free type specific data
     if (rcp_parameter_is_group(parameter))
     {
@@ -283,8 +337,11 @@ void rcp_parameter_free(rcp_parameter* parameter)
     rcp_typedefinition_free(parameter->typedefinition);
     parameter->typedefinition = NULL;
 
-    RCP_PARAMETER_MALLOC_DEBUG("+++ parameter: %p\n", parameter);
-    RCP_FREE(parameter);
+    if (parameter->arena == NULL)
+    {
+        RCP_PARAMETER_MALLOC_DEBUG("+++ parameter: %p\n", parameter);
+        RCP_FREE(parameter);
+    }
 }
 
 bool rcp_parameter_is_type(rcp_parameter* parameter, rcp_datatype type)
@@ -331,7 +388,21 @@ void rcp_parameter_set_value_updated_cb(rcp_value_parameter* parameter, void (*c
     }
 }
 
+static void _update_from(rcp_parameter* dst, rcp_parameter* src, bool move);
+
 void rcp_parameter_copy_from(rcp_parameter* dst, rcp_parameter* src)
+{
+    _update_from(dst, src, false);
+}
+
+// like rcp_parameter_copy_from - takes option data from src
+// src is left without option data
+void rcp_parameter_move_from(rcp_parameter* dst, rcp_parameter* src)
+{
+    _update_from(dst, src, true);
+}
+
+static void _update_from(rcp_parameter* dst, rcp_parameter* src, bool move)
 {
     if (dst == NULL) return;
     if (src == NULL) return;
@@ -352,6 +423,7 @@ void rcp_parameter_copy_from(rcp_parameter* dst, rcp_parameter* src)
 
 
     bool call_update_cb = false;
+    bool reindex = false;
     rcp_value_parameter* value_parameter = NULL;
 
     rcp_option* src_opt = src->options;
@@ -360,7 +432,8 @@ void rcp_parameter_copy_from(rcp_parameter* dst, rcp_parameter* src)
         RCP_PARAMETER_DEBUG("from opt: %p (%d)\n", src_opt, rcp_option_get_prefix(src_opt));
 		
         // add option or update existing option
-        rcp_option* dst_opt = rcp_option_add_or_update(&dst->options, src_opt);
+        rcp_option* dst_opt = move ? rcp_option_move_or_update(&dst->options, src_opt)
+                                   : rcp_option_add_or_update(&dst->options, src_opt);
 		
         if (rcp_option_get_prefix(src_opt) == PARAMETER_OPTIONS_VALUE)
         {
@@ -384,12 +457,22 @@ void rcp_parameter_copy_from(rcp_parameter* dst, rcp_parameter* src)
             if (rcp_option_get_prefix(src_opt) == PARAMETER_OPTIONS_PARENTID)
             {
                 rcp_parameter_resolve_parent(dst);
+                reindex = true;
+            }
+            else if (rcp_option_get_prefix(src_opt) == PARAMETER_OPTIONS_LABEL)
+            {
+                reindex = true;
             }
         }
 
         src_opt = rcp_option_get_next(src_opt);
     } // while
 
+    if (reindex)
+    {
+        rcp_manager_reindex_parameter(dst->manager, dst);
+    }
+
 
     // call update callbacks
 
@@ -509,10 +592,11 @@ void rcp_parameter_set_label(rcp_parameter* parameter, const char* label)
     // label prefix: 0x21
 
     // check if we have a label option already
-    rcp_option* opt = rcp_option_get_create(&parameter->options, PARAMETER_OPTIONS_LABEL);
+    rcp_option* opt = _get_create_option(parameter, PARAMETER_OPTIONS_LABEL);
 
     if (rcp_option_copy_any_language(opt, label, TINY_STRING))
     {
+        rcp_manager_reindex_parameter(parameter->manager, parameter);
         rcp_manager_set_dirty(parameter->manager, parameter);
     }
 }
@@ -553,7 +637,7 @@ void rcp_parameter_set_description(rcp_parameter* parameter, const char* str)
     // label prefix: 0x22
 
     // check if we got option already
-    rcp_option* opt = rcp_option_get_create(&parameter->options, PARAMETER_OPTIONS_DESCRIPTION);
+    rcp_option* opt = _get_create_option(parameter, PARAMETER_OPTIONS_DESCRIPTION);
 
     if (rcp_option_copy_any_language(opt, str, SHORT_STRING))
     {
@@ -572,36 +656,28 @@ const char* rcp_parameter_get_description(rcp_parameter* parameter)
 }
 
 
+// INFO: parameter->parent must be set to group
 static void _add_child(rcp_group_parameter* group, rcp_parameter* parameter)
 {
     if (group == NULL) return;
     if (parameter == NULL) return;
 
-    rcp_parameter_list* child = group->children;
-    while (child)
+    rcp_parameter_list* child = &parameter->child_entry;
+    if (child->parameter != NULL)
     {
-        if (child->parameter->id == parameter->id)
-        {
-            // already a child
-            return;
-        }
-
-        child = child->next;
+        // already a child
+        return;
     }
 
-    rcp_parameter_list* new_child = RCP_MALLOC(sizeof(rcp_parameter_list));
-    if (new_child)
-    {
-        RCP_PARAMETER_MALLOC_DEBUG("*** param list entry: %p\n", new_child);
-
-        new_child->next = group->children;
-        new_child->parameter = parameter;
-        group->children = new_child;
-    }
-    else
+    // add to beginning
+    child->parameter = parameter;
+    child->prev = NULL;
+    child->next = group->children;
+    if (group->children != NULL)
     {
-        RCP_ERROR("could not alloc list entry for new child!\n");
+        group->children->prev = child;
     }
+    group->children = child;
 }
 
 
@@ -610,34 +686,31 @@ static void _remove_from_parent(rcp_parameter* parameter)
     if (parameter == NULL) return;
     if (parameter->parent == NULL) return;
 
-    rcp_parameter_list* child_item = parameter->parent->children;
-    rcp_parameter_list* prev_child_item = NULL;
+    rcp_parameter_list* child_item = &parameter->child_entry;
 
-    while (child_item)
+    if (child_item->parameter != NULL)
     {
-        if (child_item->parameter->id == parameter->id)
+        // is a child, remove
+        if (child_item->prev != NULL)
         {
-            // is a child, remove
-            if (prev_child_item != NULL)
-            {
-                prev_child_item->next = child_item->next;
-            }
-            else
-            {
-                // first entry
-                parameter->parent->children = child_item->next;
-            }
-
-            child_item->next = NULL;
-            RCP_PARAMETER_MALLOC_DEBUG("+++ param list entry: %p\n", child_item);
-            RCP_FREE(child_item);
-
-            return;
+            child_item->prev->next = child_item->next;
+        }
+        else
+        {
+            // first entry
+            parameter->parent->children = child_item->next;
         }
 
-        prev_child_item = child_item;
-        child_item = child_item->next;
+        if (child_item->next != NULL)
+        {
+            child_item->next->prev = child_item->prev;
+        }
     }
+
+    child_item->next = NULL;
+    child_item->prev = NULL;
+    child_item->parameter = NULL;
+    parameter->parent = NULL;
 }
 
 //-------------------
@@ -672,10 +745,11 @@ void rcp_parameter_set_parent(rcp_parameter* parameter, rcp_group_parameter* gro
     _add_child(group, parameter);
 
     // set option
-    rcp_option* opt = rcp_option_get_create(&parameter->options, PARAMETER_OPTIONS_PARENTID);
+    rcp_option* opt = _get_create_option(parameter, PARAMETER_OPTIONS_PARENTID);
     rcp_option_free_data(opt);
     if (rcp_option_set_i16(opt, rcp_parameter_get_id(RCP_PARAMETER(group))))
     {
+        rcp_manager_reindex_parameter(parameter->manager, parameter);
         rcp_manager_set_dirty(parameter->manager, parameter);
     }
 }
@@ -686,6 +760,17 @@ rcp_group_parameter* rcp_parameter_get_parent(rcp_parameter* parameter)
     return NULL;
 }
 
+// parent id from option - also valid if parent is not resolved
+int16_t rcp_parameter_get_parent_id(rcp_parameter* parameter)
+{
+    if (parameter == NULL) return 0;
+
+    rcp_option* parent_option = rcp_option_get(parameter->options, PARAMETER_OPTIONS_PARENTID);
+    if (parent_option == NULL) return 0;
+
+    return rcp_option_get_i16(parent_option);
+}
+
 void rcp_parameter_resolve_parent(rcp_parameter* parameter)
 {
     if (parameter == NULL) return;
@@ -718,8 +803,11 @@ void rcp_parameter_resolve_parent(rcp_parameter* parameter)
         {
             if (rcp_parameter_is_group(group))
             {
-                // set as parent
-                rcp_parameter_set_parent(parameter, RCP_GROUP_PARAMETER(group));
+                // link only - parent id option is set already
+                // setting it would mark the parameter dirty and send it back
+                _remove_from_parent(parameter);
+                parameter->parent = RCP_GROUP_PARAMETER(group);
+                _add_child(parameter->parent, parameter);
             }
             else
             {
@@ -740,6 +828,57 @@ void rcp_parameter_resolve_parent(rcp_parameter* parameter)
 }
 
 
+/*
+ * send interval
+ *
+ * minimum time between two updates sent by the manager
+ * groups apply their interval to all children without an interval
+ *
+ */
+void rcp_parameter_set_send_interval(rcp_parameter* parameter, uint32_t interval_ms)
+{
+    if (parameter == NULL) return;
+
+    parameter->send_interval = interval_ms;
+}
+
+uint32_t rcp_parameter_get_send_interval(rcp_parameter* parameter)
+{
+    if (parameter == NULL) return 0;
+
+    return parameter->send_interval;
+}
+
+uint32_t rcp_parameter_get_effective_send_interval(rcp_parameter* parameter)
+{
+    while (parameter != NULL)
+    {
+        if (parameter->send_interval > 0)
+        {
+            return parameter->send_interval;
+        }
+
+        parameter = RCP_PARAMETER(parameter->parent);
+    }
+
+    return 0;
+}
+
+void rcp_parameter_set_last_sent(rcp_parameter* parameter, uint64_t time)
+{
+    if (parameter == NULL) return;
+
+    parameter->last_sent = time;
+}
+
+uint64_t rcp_parameter_get_last_sent(rcp_parameter* parameter)
+{
+    if (parameter == NULL) return 0;
+
+    return parameter->last_sent;
+}
+
+
 /*
  * user data
  *
@@ -752,7 +891,7 @@ void rcp_parameter_set_userdata(rcp_parameter* parameter, void* data, size_t siz
     if (parameter == NULL) return;
 
     // check if we have that option
-    rcp_option* opt = rcp_option_get_create(&parameter->options, PARAMETER_OPTIONS_USERDATA);
+    rcp_option* opt = _get_create_option(parameter, PARAMETER_OPTIONS_USERDATA);
 
     // set data
     if (opt != NULL &&
@@ -767,7 +906,7 @@ void rcp_parameter_copy_userdata(rcp_parameter* parameter, void* data, size_t si
     if (parameter == NULL) return;
 
     // check if we have that option
-    rcp_option* opt = rcp_option_get_create(&parameter->options, PARAMETER_OPTIONS_USERDATA);
+    rcp_option* opt = _get_create_option(parameter, PARAMETER_OPTIONS_USERDATA);
 
     // copy data
     if (opt != NULL &&
@@ -796,7 +935,7 @@ static inline void _parameter_set_string_option(rcp_parameter* parameter,
     RCP_PARAMETER_DEBUG("parameter_set string option type: %d\n", option);
 
     // check if we have that option
-    rcp_option* opt = rcp_option_get_create(&parameter->options, option);
+    rcp_option* opt = _get_create_option(parameter, option);
 
     RCP_PARAMETER_DEBUG("parameter_set string option: %p\n", opt);
 
@@ -871,9 +1010,10 @@ void rcp_parameter_set_order(rcp_parameter* parameter, int32_t order)
     if (parameter == NULL) return;
 
     // check if we have that option
-    rcp_option* opt = rcp_option_get_create(&parameter->options, PARAMETER_OPTIONS_ORDER);
+    rcp_option* opt = _get_create_option(parameter, PARAMETER_OPTIONS_ORDER);
 
-    if (rcp_option_get_i32(opt) == order)
+    if (rcp_option_has_data(opt) &&
+            rcp_option_get_i32(opt) == order)
     {
         // same value... leave it
         rcp_option_set_changed(opt, false);
@@ -925,9 +1065,10 @@ void rcp_parameter_set_readonly(rcp_parameter* parameter, bool ro)
     if (parameter == NULL) return;
 
     // check if we have that option
-    rcp_option* opt = rcp_option_get_create(&parameter->options, PARAMETER_OPTIONS_READONLY);
+    rcp_option* opt = _get_create_option(parameter, PARAMETER_OPTIONS_READONLY);
 
-    if (rcp_option_get_bool(opt) == ro)
+    if (rcp_option_has_data(opt) &&
+            rcp_option_get_bool(opt) == ro)
     {
         // same value... leave it
         rcp_option_set_changed(opt, false);
@@ -983,7 +1124,7 @@ static bool validate_value_parameter(rcp_value_parameter* parameter, rcp_datatyp
 	
     if (parameter->value_option == NULL)
     {
-		parameter->value_option = rcp_option_get_create(&parameter->parameter_base.options, PARAMETER_OPTIONS_VALUE);
+		parameter->value_option = _get_create_option(RCP_PARAMETER(parameter), PARAMETER_OPTIONS_VALUE);
 	}
 
 	if (parameter->value_option == NULL)
@@ -1788,7 +1929,7 @@ void rcp_parameter_set_external_value_cb(rcp_value_parameter* parameter, void (*
 
     if (parameter->value_option == NULL)
     {
-        parameter->value_option = rcp_option_get_create(&parameter->parameter_base.options, PARAMETER_OPTIONS_VALUE);
+        parameter->value_option = _get_create_option(RCP_PARAMETER(parameter), PARAMETER_OPTIONS_VALUE);
     }
 
     rcp_option_set_external_cb(parameter->value_option, getCb, setCb);
@@ -1803,7 +1944,7 @@ void rcp_parameter_set_external_value_cb(rcp_value_parameter* parameter, void (*
  *
  *
  */
-const char* rcp_parameter_parse_value(rcp_parameter* parameter, const char* data, size_t* size)
+const char* rcp_parameter_parse_value(rcp_parameter* parameter, const char* data, size_t* size, bool borrow)
 {
     if (parameter == NULL) return NULL;
 
@@ -1822,7 +1963,7 @@ const char* rcp_parameter_parse_value(rcp_parameter* parameter, const char* data
 
     if (is_value_type(rcp_typedefinition_get_type_id(parameter->typedefinition)))
     {
-        rcp_option* opt = rcp_option_get_create(&parameter->options, PARAMETER_OPTIONS_VALUE);
+        rcp_option* opt = _get_create_option(parameter, PARAMETER_OPTIONS_VALUE);
 
         switch (rcp_typedefinition_get_type_id(parameter->typedefinition))
         {
@@ -1856,7 +1997,7 @@ const char* rcp_parameter_parse_value(rcp_parameter* parameter, const char* data
         case DATATYPE_STRING:
         case DATATYPE_ENUM:
         {
-            data = rcp_typedefinition_parse_string_value(parameter->typedefinition, data, size, opt);
+            data = rcp_typedefinition_parse_string_value(parameter->typedefinition, data, size, opt, borrow);
             if (data == NULL) return NULL;
 
             RCP_VALUE_PARAMETER(parameter)->value_option = opt;
@@ -1875,6 +2016,7 @@ const char* rcp_parameter_parse_value(rcp_parameter* parameter, const char* data
             rcp_option_copy_data(opt, data, p_size, false);
             RCP_VALUE_PARAMETER(parameter)->value_option = opt;
 
+            *size -= p_size;
             return data + p_size;
         }
 
@@ -1893,6 +2035,142 @@ const char* rcp_parameter_parse_value(rcp_parameter* parameter, const char* data
     return data;
 }
 
+/*
+ * APPLY VALUE
+ *
+ * decode a value of fixed size directly into the existing value option
+ * no temporary parameter is created and no memory is allocated
+ *
+ * return
+ *   a pointer to the data after the value
+ *   or NULL if the value was not applied (size or type not handled)
+ *   data and size are untouched in that case
+ */
+const char* rcp_parameter_apply_value(rcp_parameter* parameter, const char* data, size_t* size)
+{
+    if (parameter == NULL) return NULL;
+    if (data == NULL) return NULL;
+    if (size == NULL) return NULL;
+
+    // group and bang parameters have no value option
+    if (!rcp_parameter_is_value(parameter)) return NULL;
+
+    rcp_option* opt = RCP_VALUE_PARAMETER(parameter)->value_option;
+    if (opt == NULL) return NULL;
+
+    const char* r_data = NULL;
+    size_t r_size = *size;
+
+    switch (rcp_typedefinition_get_type_id(parameter->typedefinition))
+    {
+    case DATATYPE_BOOLEAN:
+    {
+        int8_t val = 0;
+        r_data = rcp_read_i8(data, &r_size, &val);
+        if (r_data == NULL) return NULL;
+
+        rcp_option_set_bool(opt, (val > 0));
+        break;
+    }
+
+    case DATATYPE_INT8:
+    case DATATYPE_UINT8:
+    {
+        int8_t val = 0;
+        r_data = rcp_read_i8(data, &r_size, &val);
+        if (r_data == NULL) return NULL;
+
+        rcp_option_set_i8(opt, val);
+        break;
+    }
+
+    case DATATYPE_INT16:
+    case DATATYPE_UINT16:
+    {
+        int16_t val = 0;
+        r_data = rcp_read_i16(data, &r_size, &val);
+        if (r_data == NULL) return NULL;
+
+        rcp_option_set_i16(opt, val);
+        break;
+    }
+
+    case DATATYPE_INT32:
+    case DATATYPE_UINT32:
+    case DATATYPE_RGB:
+    case DATATYPE_IPV4:
+    {
+        int32_t val = 0;
+        r_data = rcp_read_i32(data, &r_size, &val);
+        if (r_data == NULL) return NULL;
+
+        rcp_option_set_i32(opt, val);
+        break;
+    }
+
+    case DATATYPE_INT64:
+    case DATATYPE_UINT64:
+    {
+        int64_t val = 0;
+        r_data = rcp_read_i64(data, &r_size, &val);
+        if (r_data == NULL) return NULL;
+
+        rcp_option_set_i64(opt, val);
+        break;
+    }
+
+    case DATATYPE_FLOAT32:
+    {
+        float val = 0;
+        r_data = rcp_read_f32(data, &r_size, &val);
+        if (r_data == NULL) return NULL;
+
+        rcp_option_set_f32(opt, val);
+        break;
+    }
+
+    case DATATYPE_FLOAT64:
+    {
+        double val = 0;
+        r_data = rcp_read_f64(data, &r_size, &val);
+        if (r_data == NULL) return NULL;
+
+        rcp_option_set_f64(opt, val);
+        break;
+    }
+
+    case DATATYPE_VECTOR2F32:
+    {
+        // the vector is only created if the option does not hold one yet
+        float x = 0;
+        float y = 0;
+        r_data = rcp_read_f32(data, &r_size, &x);
+        if (r_data == NULL) return NULL;
+
+        r_data = rcp_read_f32(r_data, &r_size, &y);
+        if (r_data == NULL) return NULL;
+
+        rcp_option_set_vector2f(opt, x, y);
+        break;
+    }
+
+    default:
+        // strings, enums and custom types take the regular path
+        return NULL;
+    }
+
+    // like rcp_parameter_copy_from: a received value is always marked changed
+    rcp_option_set_changed(opt, true);
+    *size = r_size;
+
+    if (RCP_VALUE_PARAMETER(parameter)->valueUpdatedCb != NULL)
+    {
+        RCP_VALUE_PARAMETER(parameter)->valueUpdatedCb(RCP_VALUE_PARAMETER(parameter), parameter->user);
+    }
+
+    return r_data;
+}
+
 
 /*
  * PARSE OPTIONS
@@ -1900,7 +2178,7 @@ const char* rcp_parameter_parse_value(rcp_parameter* parameter, const char* data
  *
  *
  */
-const char* rcp_parameter_parse_options(rcp_parameter* parameter, const char* data, size_t* size)
+const char* rcp_parameter_parse_options(rcp_parameter* parameter, const char* data, size_t* size, bool borrow)
 {
     if (parameter == NULL) return NULL;
     if (data == NULL || *size == 0) return data;
@@ -1949,7 +2227,7 @@ const char* rcp_parameter_parse_options(rcp_parameter* parameter, const char* da
         {
         case PARAMETER_OPTIONS_VALUE:
         {
-            const char* r_data = rcp_parameter_parse_value(parameter, data, size);
+            const char* r_data = rcp_parameter_parse_value(parameter, data, size, borrow);
             if (r_data == NULL)
             {
                 return NULL;
@@ -1967,7 +2245,7 @@ const char* rcp_parameter_parse_options(rcp_parameter* parameter, const char* da
             rcp_language_str* lng_strs = NULL;
             char code[RCP_LANGUAGE_CODE_SIZE];
 
-            while (*data > 0)
+            while (*size > 0 && *data > 0)
             {
                 if (*size < RCP_LANGUAGE_CODE_SIZE)
                 {
@@ -1991,10 +2269,10 @@ const char* rcp_parameter_parse_options(rcp_parameter* parameter, const char* da
                 *size -= RCP_LANGUAGE_CODE_SIZE;
 
                 // tiny string
-                uint8_t str_len = 0;
-                char* str = NULL;
+                uint32_t str_len = 0;
+                const char* str = NULL;
 
-                const char* r_data = rcp_read_tiny_string(data, size, &str, &str_len);
+                const char* r_data = rcp_read_string_view(data, size, TINY_STRING, &str, &str_len);
                 if (r_data == NULL)
                 {
                     rcp_langstr_free_chain(lng_strs);
@@ -2004,12 +2282,19 @@ const char* rcp_parameter_parse_options(rcp_parameter* parameter, const char* da
 
                 data = r_data;
 
-                rcp_langstr_set_string(lng_str, str, str_len, TINY_STRING);
+                rcp_langstr_set_view(lng_str, str, str_len, TINY_STRING, borrow);
                 rcp_langstr_set_next(lng_str, lng_strs);
                 lng_strs = lng_str;                
 
-                RCP_PARAMETER_DEBUG("label: %s: %s\n", rcp_langstr_get_code(lng_str), rcp_langstr_get_string(lng_str));
+                RCP_PARAMETER_DEBUG("label: %.3s: %.*s\n", rcp_langstr_get_code(lng_str), (int)str_len, str);
             }
+            if (*size == 0)
+            {
+                // missing terminator
+                rcp_langstr_free_chain(lng_strs);
+                return NULL;
+            }
+
             // step over terminator
             data++;
             *size -= 1;
@@ -2017,7 +2302,7 @@ const char* rcp_parameter_parse_options(rcp_parameter* parameter, const char* da
             if (lng_strs != NULL)
             {
                 // got strings...
-                opt = rcp_option_get_create(&parameter->options, PARAMETER_OPTIONS_LABEL);
+                opt = _get_create_option(parameter, PARAMETER_OPTIONS_LABEL);
                 rcp_option_move_langstr(opt, lng_strs);
             }
 
@@ -2034,7 +2319,7 @@ const char* rcp_parameter_parse_options(rcp_parameter* parameter, const char* da
             rcp_language_str* lng_strs = NULL;
             char code[RCP_LANGUAGE_CODE_SIZE];
 
-            while (*data > 0)
+            while (*size > 0 && *data > 0)
             {
                 if (*size < RCP_LANGUAGE_CODE_SIZE)
                 {
@@ -2058,9 +2343,9 @@ const char* rcp_parameter_parse_options(rcp_parameter* parameter, const char* da
                 *size -= RCP_LANGUAGE_CODE_SIZE;
 
                 // short string
-                uint16_t str_len;
-                char* str;
-                const char* r_data = rcp_read_short_string(data, size, &str, &str_len);
+                uint32_t str_len = 0;
+                const char* str = NULL;
+                const char* r_data = rcp_read_string_view(data, size, SHORT_STRING, &str, &str_len);
                 if (r_data == NULL)
                 {
                     rcp_langstr_free_chain(lng_strs);
@@ -2070,11 +2355,18 @@ const char* rcp_parameter_parse_options(rcp_parameter* parameter, const char* da
 
                 data = r_data;
 
-                rcp_langstr_set_string(lng_str, str, str_len, SHORT_STRING);
+                rcp_langstr_set_view(lng_str, str, str_len, SHORT_STRING, borrow);
                 rcp_langstr_set_next(lng_str, lng_strs);
                 lng_strs = lng_str;
 
-                RCP_PARAMETER_DEBUG("description: %s: %s\n", rcp_langstr_get_code(lng_str), rcp_langstr_get_string(lng_str));
+                RCP_PARAMETER_DEBUG("description: %.3s: %.*s\n", rcp_langstr_get_code(lng_str), (int)str_len, str);
+            }
+
+            if (*size == 0)
+            {
+                // missing terminator
+                rcp_langstr_free_chain(lng_strs);
+                return NULL;
             }
 
             // step over terminator
@@ -2084,7 +2376,7 @@ const char* rcp_parameter_parse_options(rcp_parameter* parameter, const char* da
             if (lng_strs != NULL)
             {
                 // got strings...
-                opt = rcp_option_get_create(&parameter->options, PARAMETER_OPTIONS_DESCRIPTION);
+                opt = _get_create_option(parameter, PARAMETER_OPTIONS_DESCRIPTION);
                 rcp_option_move_langstr(opt, lng_strs);
             }
 
@@ -2105,7 +2397,7 @@ const char* rcp_parameter_parse_options(rcp_parameter* parameter, const char* da
         case PARAMETER_OPTIONS_ORDER:
         {
             // int32
-            opt = rcp_option_get_create(&parameter->options, PARAMETER_OPTIONS_ORDER);
+            opt = _get_create_option(parameter, PARAMETER_OPTIONS_ORDER);
             rcp_option_free_data(opt);
 
             int32_t d;
@@ -2119,7 +2411,7 @@ const char* rcp_parameter_parse_options(rcp_parameter* parameter, const char* da
         case PARAMETER_OPTIONS_PARENTID:
         {
             // int16
-            opt = rcp_option_get_create(&parameter->options, PARAMETER_OPTIONS_PARENTID);
+            opt = _get_create_option(parameter, PARAMETER_OPTIONS_PARENTID);
             rcp_option_free_data(opt);
 
             int16_t d;
@@ -2149,7 +2441,7 @@ const char* rcp_parameter_parse_options(rcp_parameter* parameter, const char* da
             }
 
             // copy data
-            opt = rcp_option_get_create(&parameter->options, PARAMETER_OPTIONS_USERDATA);
+            opt = _get_create_option(parameter, PARAMETER_OPTIONS_USERDATA);
             if (opt != NULL)
             {
                 rcp_option_copy_data(opt, data, data_size, true);
@@ -2178,7 +2470,7 @@ const char* rcp_parameter_parse_options(rcp_parameter* parameter, const char* da
         case PARAMETER_OPTIONS_READONLY:
         {
             // int8
-            opt = rcp_option_get_create(&parameter->options, PARAMETER_OPTIONS_READONLY);
+            opt = _get_create_option(parameter, PARAMETER_OPTIONS_READONLY);
             rcp_option_free_data(opt);
 
             int8_t d;
@@ -2267,12 +2559,20 @@ void rcp_parameter_log(rcp_parameter* parameter)
                     break;
 
                 case DATATYPE_STRING:
-                    RCP_INFO_ONLY("%s\n", rcp_option_get_string(opt, LONG_STRING));
+                {
+                    size_t str_len = 0;
+                    const char* str = rcp_option_get_string_view(opt, LONG_STRING, &str_len);
+                    RCP_INFO_ONLY("%.*s\n", (int)str_len, str);
                     break;
+                }
 
                 case DATATYPE_ENUM:
-                    RCP_INFO_ONLY("%s\n", rcp_option_get_string(opt, TINY_STRING));
+                {
+                    size_t str_len = 0;
+                    const char* str = rcp_option_get_string_view(opt, TINY_STRING, &str_len);
+                    RCP_INFO_ONLY("%.*s\n", (int)str_len, str);
                     break;
+                }
 
                 case DATATYPE_IPV4:
                 {
@@ -2418,7 +2718,8 @@ size_t rcp_parameter_get_size(rcp_parameter* parameter, bool all)
 
 
 
-size_t rcp_parameter_write(rcp_parameter* parameter, char* data, size_t size, bool all)
+// value: false to leave out the value option
+static size_t _write(rcp_parameter* parameter, char* data, size_t size, bool all, bool value)
 {
     if (parameter == NULL) return 0;
     if (data == NULL) return 0;
@@ -2466,7 +2767,8 @@ size_t rcp_parameter_write(rcp_parameter* parameter, char* data, size_t size, bo
     rcp_option* opt = parameter->options;
     while (opt)
     {
-        if (all || rcp_option_is_changed(opt))
+        if ((all || rcp_option_is_changed(opt))
+                && (value || rcp_option_get_prefix(opt) != PARAMETER_OPTIONS_VALUE))
         {
             written_len = rcp_option_write(opt, data, size - written, all);
             if (written_len == 0)
@@ -2504,7 +2806,58 @@ size_t rcp_parameter_write(rcp_parameter* parameter, char* data, size_t size, bo
     return written;
 }
 
-size_t rcp_parameter_write_updatevalue(rcp_parameter* parameter, char* dst, size_t size)
+size_t rcp_parameter_write(rcp_parameter* parameter, char* data, size_t size, bool all)
+{
+    return _write(parameter, data, size, all, true);
+}
+
+// complete UPDATE packet with all options except the value
+size_t rcp_parameter_write_metadata_packet(rcp_parameter* parameter, char* dst, size_t size)
+{
+    if (dst == NULL) return 0;
+
+    // command(1) + data option(1) + terminator(1)
+    if (size < 3) return 0;
+
+    dst[0] = COMMAND_UPDATE;
+    dst[1] = PACKET_OPTIONS_DATA;
+
+    size_t written = _write(parameter, dst + 2, size - 3, true, false);
+    if (written == 0) return 0;
+
+    dst[2 + written] = RCP_TERMINATOR;
+
+    return written + 3;
+}
+
+// build UPDATEVALUE header on first use
+// command(1), id(2), type-id(1)
+// the size of custom types can change - it is written by _write_updatevalue
+static size_t _updatevalue_header(rcp_parameter* parameter)
+{
+    if (parameter->value_header_size > 0)
+    {
+        return parameter->value_header_size;
+    }
+
+    if (parameter->typedefinition == NULL)
+    {
+        RCP_PARAMETER_DEBUG("could not write updatevalue header\n");
+        return 0;
+    }
+
+    char* header = parameter->value_header;
+    header[0] = COMMAND_UPDATEVALUE;
+    _rcp_store16(header + 1, (uint16_t)parameter->id);
+    header[3] = RCP_TYPE_ID(parameter);
+
+    parameter->value_header_size = 4;
+
+    return parameter->value_header_size;
+}
+
+// skip: 1 to skip the command
+static size_t _write_updatevalue(rcp_parameter* parameter, char* dst, size_t size, size_t skip)
 {
     if (dst == NULL
             || parameter == NULL)
@@ -2512,45 +2865,78 @@ size_t rcp_parameter_write_updatevalue(rcp_parameter* parameter, char* dst, size
         return 0;
     }
 
-    if (size < 2)
+    if (rcp_parameter_is_value(parameter)
+            && RCP_VALUE_PARAMETER(parameter)->value_option == NULL)
     {
-        RCP_PARAMETER_DEBUG("could not write id - buffer overflow\n");
+        // nothing to update - a value is mandatory
+        RCP_PARAMETER_DEBUG("could not write updatevalue - no value\n");
         return 0;
     }
 
-    // write data
-    size_t written = 0;
+    size_t header_size = _updatevalue_header(parameter);
+    if (header_size == 0) return 0;
 
-    // write parameter id
-    _rcp_store16(dst, (uint16_t)parameter->id);
-    written += 2;
-    // check
-    if (written >= size) return 0;
-    // move pointer
-    dst += 2;
+    header_size -= skip;
 
+    if (size < header_size)
+    {
+        RCP_PARAMETER_DEBUG("could not write updatevalue header - buffer overflow\n");
+        return 0;
+    }
 
-    // write mandatory typedefinition
-    rcp_typedefinition* typedefinition = rcp_parameter_get_typedefinition(parameter);
+    memcpy(dst, parameter->value_header + skip, header_size);
 
-    size_t written_len = rcp_typedefinition_write_mandatory(typedefinition, dst, size);
-    if (written_len == 0) return 0;
+    size_t written = header_size;
 
-    written += written_len;
-    // check
-    if (written >= size) return 0;
-    // move pointer
-    dst += written_len;
+    if (RCP_TYPE_ID(parameter) == DATATYPE_CUSTOMTYPE)
+    {
+        // type-id and current size
+        char mandatory[8];
+        size_t mandatory_len = rcp_typedefinition_write_mandatory(parameter->typedefinition,
+                                                                  mandatory,
+                                                                  sizeof(mandatory));
+        if (mandatory_len == 0 ||
+                size - written < mandatory_len - 1)
+        {
+            RCP_PARAMETER_DEBUG("could not write updatevalue header - buffer overflow\n");
+            return 0;
+        }
+
+        memcpy(dst + written, mandatory + 1, mandatory_len - 1);
+        written += mandatory_len - 1;
+    }
 
     if (rcp_parameter_is_value(parameter))
     {
-        // write value
-        written += rcp_option_write_value(RCP_VALUE_PARAMETER(parameter)->value_option, dst, size);
+        rcp_option* opt = RCP_VALUE_PARAMETER(parameter)->value_option;
+
+        // store scalars directly, anything else as option value
+        size_t written_len = rcp_option_write_scalar(opt, dst + written, size - written);
+        if (written_len == 0)
+        {
+            written_len = rcp_option_write_value(opt, dst + written, size - written);
+        }
+
+        if (written_len == 0) return 0;
+
+        written += written_len;
     }
 
     return written;
 }
 
+// id, type-id and value
+size_t rcp_parameter_write_updatevalue(rcp_parameter* parameter, char* dst, size_t size)
+{
+    return _write_updatevalue(parameter, dst, size, 1);
+}
+
+// complete UPDATEVALUE packet
+size_t rcp_parameter_write_updatevalue_packet(rcp_parameter* parameter, char* dst, size_t size)
+{
+    return _write_updatevalue(parameter, dst, size, 0);
+}
+
 
 void rcp_parameter_all_options_changed(rcp_parameter* parameter)
 {
@@ -2588,6 +2974,42 @@ void rcp_parameter_set_manager(rcp_parameter* parameter, rcp_manager* manager)
     parameter->manager = manager;    
 }
 
+rcp_parameter_list* rcp_parameter_get_dirty_entry(rcp_parameter* parameter)
+{
+    if (parameter == NULL) return NULL;
+
+    parameter->dirty_entry.parameter = parameter;
+    return &parameter->dirty_entry;
+}
+
+bool rcp_parameter_is_queued(rcp_parameter* parameter)
+{
+    if (parameter == NULL) return false;
+
+    return parameter->queued;
+}
+
+void rcp_parameter_set_queued(rcp_parameter* parameter, bool queued)
+{
+    if (parameter == NULL) return;
+
+    parameter->queued = queued;
+}
+
+bool rcp_parameter_is_throttled(rcp_parameter* parameter)
+{
+    if (parameter == NULL) return false;
+
+    return parameter->throttled;
+}
+
+void rcp_parameter_set_throttled(rcp_parameter* parameter, bool throttled)
+{
+    if (parameter == NULL) return;
+
+    parameter->throttled = throttled;
+}
+
 bool rcp_parameter_is_value(rcp_parameter* parameter)
 {
     if (parameter != NULL)
@@ -34,6 +34,7 @@ extern "C"{
 #include "rcp_option_type.h"
 #include "rcp_manager_type.h"
 #include "rcp_typedefinition_type.h"
+#include "rcp_arena.h"
 
 //#define RCP_PARAMETER_DEBUG_LOG
 //#define RCP_PARAMETER_MALLOC_DEBUG_LOG
@@ -69,6 +70,11 @@ rcp_value_parameter* rcp_custom_parameter_create(int16_t id, uint32_t size);
 
 rcp_bang_parameter* rcp_bang_parameter_create(int16_t id);
 
+// create parameter of type from arena (NULL: heap)
+// parameters from an arena are released with the arena
+// rcp_parameter_free only releases their option data
+rcp_parameter* rcp_parameter_create_in(int16_t id, rcp_datatype type, rcp_arena* arena);
+
 
 
 
@@ -78,9 +84,15 @@ void rcp_parameter_free(rcp_parameter* param);
 
 // copy
 void rcp_parameter_copy_from(rcp_parameter* dst, rcp_parameter* src);
+void rcp_parameter_move_from(rcp_parameter* dst, rcp_parameter* src); // takes option data from src
 
 // manager
 void rcp_parameter_set_manager(rcp_parameter* parameter, rcp_manager* manager);
+rcp_parameter_list* rcp_parameter_get_dirty_entry(rcp_parameter* parameter); // no transfer
+bool rcp_parameter_is_queued(rcp_parameter* parameter);
+void rcp_parameter_set_queued(rcp_parameter* parameter, bool queued);
+bool rcp_parameter_is_throttled(rcp_parameter* parameter);
+void rcp_parameter_set_throttled(rcp_parameter* parameter, bool throttled);
 
 // getter id, typedefinition
 int16_t rcp_parameter_get_id(rcp_parameter* parameter);
@@ -258,8 +270,16 @@ bool rcp_parameter_get_readonly(rcp_parameter* parameter);
 // parent
 void rcp_parameter_set_parent(rcp_parameter* parameter, rcp_group_parameter* group);
 rcp_group_parameter* rcp_parameter_get_parent(rcp_parameter* parameter);
+int16_t rcp_parameter_get_parent_id(rcp_parameter* parameter);
 void rcp_parameter_resolve_parent(rcp_parameter* parameter);
 
+// send interval
+void rcp_parameter_set_send_interval(rcp_parameter* parameter, uint32_t interval_ms); // 0: no limit
+uint32_t rcp_parameter_get_send_interval(rcp_parameter* parameter);
+uint32_t rcp_parameter_get_effective_send_interval(rcp_parameter* parameter); // inherited from groups
+void rcp_parameter_set_last_sent(rcp_parameter* parameter, uint64_t time);
+uint64_t rcp_parameter_get_last_sent(rcp_parameter* parameter);
+
 // userdata
 void rcp_parameter_set_userdata(rcp_parameter* parameter, void* data, size_t size);
 void rcp_parameter_copy_userdata(rcp_parameter* parameter, void* data, size_t size);
@@ -270,8 +290,11 @@ void rcp_parameter_set_userid(rcp_parameter* parameter, const char* userid);
 const char* rcp_parameter_get_userid(rcp_parameter* parameter);
 
 // parsing
-const char* rcp_parameter_parse_value(rcp_parameter* parameter, const char* data, size_t* size);
-const char* rcp_parameter_parse_options(rcp_parameter* parameter, const char* data, size_t* size);
+// borrow: strings reference data instead of owning a copy
+// borrowed strings are only available through the string view getters
+const char* rcp_parameter_parse_value(rcp_parameter* parameter, const char* data, size_t* size, bool borrow);
+const char* rcp_parameter_parse_options(rcp_parameter* parameter, const char* data, size_t* size, bool borrow);
+const char* rcp_parameter_apply_value(rcp_parameter* parameter, const char* data, size_t* size); // in place, no allocation
 
 // size and writing
 size_t rcp_parameter_get_size(rcp_parameter* parameter, bool all);
@@ -279,6 +302,8 @@ size_t rcp_parameter_get_value_size(rcp_value_parameter* parameter);
 
 size_t rcp_parameter_write(rcp_parameter* parameter, char* dst, size_t size, bool all);
 size_t rcp_parameter_write_updatevalue(rcp_parameter* parameter, char* dst, size_t size);
+size_t rcp_parameter_write_updatevalue_packet(rcp_parameter* parameter, char* dst, size_t size); // including command
+size_t rcp_parameter_write_metadata_packet(rcp_parameter* parameter, char* dst, size_t size); // UPDATE without value
 
 // callbacks
 void rcp_parameter_set_user(rcp_parameter* parameter, void* user);
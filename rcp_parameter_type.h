@@ -42,6 +42,7 @@ struct rcp_parameter_list
 {
     rcp_parameter_list* next;
     rcp_parameter* parameter;
+    rcp_parameter_list* prev;
 };
 
 
@@ -150,7 +150,7 @@ const char* rcp_read_f64(const char* data, size_t* size, double* target)
 
 
 
-static rcp_parameter* _create_parameter_from_data(const char** data, size_t* size)
+static rcp_parameter* _create_parameter_from_data(const char** data, size_t* size, rcp_arena* arena)
 {
     if (data == NULL) return NULL;
     if (*data == NULL) return NULL;
@@ -177,54 +177,26 @@ static rcp_parameter* _create_parameter_from_data(const char** data, size_t* siz
 
         if (parameter_id != 0)
         {
-            switch (datatype_id)
+            if (datatype_id == DATATYPE_CUSTOMTYPE)
             {
-                case DATATYPE_BOOLEAN:
-                    return RCP_PARAMETER(rcp_bool_parameter_create(parameter_id));
-                case DATATYPE_INT8:
-                    return RCP_PARAMETER(rcp_i8_parameter_create(parameter_id));
-                case DATATYPE_UINT8:
-                    return RCP_PARAMETER(rcp_u8_parameter_create(parameter_id));
-                case DATATYPE_INT16:
-                    return RCP_PARAMETER(rcp_i16_parameter_create(parameter_id));
-                case DATATYPE_UINT16:
-                    return RCP_PARAMETER(rcp_u16_parameter_create(parameter_id));
-                case DATATYPE_INT32:
-                    return RCP_PARAMETER(rcp_i32_parameter_create(parameter_id));
-                case DATATYPE_UINT32:
-                    return RCP_PARAMETER(rcp_u32_parameter_create(parameter_id));
-                case DATATYPE_FLOAT32:
-                    return RCP_PARAMETER(rcp_f32_parameter_create(parameter_id));
-                case DATATYPE_VECTOR2F32:
-                    return RCP_PARAMETER(rcp_vector2f32_parameter_create(parameter_id));
-                case DATATYPE_STRING:
-                    return RCP_PARAMETER(rcp_string_parameter_create(parameter_id));
-                case DATATYPE_ENUM:
-                    return RCP_PARAMETER(rcp_enum_parameter_create(parameter_id));
-                case DATATYPE_BANG:
-                    return RCP_PARAMETER(rcp_bang_parameter_create(parameter_id));
-                case DATATYPE_GROUP:
-                    return RCP_PARAMETER(rcp_group_parameter_create(parameter_id));
-                case DATATYPE_IPV4:
-                    return RCP_PARAMETER(rcp_ipv4_parameter_create(parameter_id));
-
-                case DATATYPE_CUSTOMTYPE:
-                {
-                    // parse size
-                    uint32_t p_size = 0;
-                    r_data = rcp_read_i32(*data, size, (int32_t*)&p_size);
+                // parse size
+                uint32_t p_size = 0;
+                r_data = rcp_read_i32(*data, size, (int32_t*)&p_size);
 
-                    if (r_data == NULL) return NULL;
+                if (r_data == NULL) return NULL;
 
-                    *data = r_data;
+                *data = r_data;
 
-                    return RCP_PARAMETER(rcp_custom_parameter_create(parameter_id, p_size));
+                rcp_parameter* parameter = rcp_parameter_create_in(parameter_id, datatype_id, arena);
+                if (parameter != NULL)
+                {
+                    rcp_typedefinition_custom_set_size((rcp_typedefinition_custom*)rcp_parameter_get_typedefinition(parameter), p_size);
                 }
 
-                default:
-                RCP_DEBUG("type id not implemented: %d\n", datatype_id);
-                    break;
+                return parameter;
             }
+
+            return rcp_parameter_create_in(parameter_id, datatype_id, arena);
         }
 
         return NULL;
@@ -234,17 +206,17 @@ static rcp_parameter* _create_parameter_from_data(const char** data, size_t* siz
     return NULL;
 }
 
-rcp_parameter* rcp_parse_parameter(const char** data, size_t* size)
+rcp_parameter* rcp_parse_parameter(const char** data, size_t* size, rcp_arena* arena, bool borrow)
 {
     // smalles possible parameter = 5 bytes (2byte id, 1byte typeid, term, term)
     if (*size < 5) return NULL;
 
-    rcp_parameter* parameter = _create_parameter_from_data(data, size);
+    rcp_parameter* parameter = _create_parameter_from_data(data, size, arena);
 
     if (parameter)
     {
         // parse type-options
-        const char* r_data = rcp_typedefinition_parse_type_options(rcp_parameter_get_typedefinition(parameter), *data, size);
+        const char* r_data = rcp_typedefinition_parse_type_options(rcp_parameter_get_typedefinition(parameter), *data, size, borrow);
         if (r_data == NULL)
         {
             rcp_parameter_free(parameter);
@@ -256,7 +228,7 @@ rcp_parameter* rcp_parse_parameter(const char** data, size_t* size)
         if (*size > 0)
         {
             // parse parameter options
-            const char* r_data = rcp_parameter_parse_options(parameter, *data, size);
+            const char* r_data = rcp_parameter_parse_options(parameter, *data, size, borrow);
             if (r_data == NULL)
             {
                 rcp_parameter_free(parameter);
@@ -271,7 +243,7 @@ rcp_parameter* rcp_parse_parameter(const char** data, size_t* size)
 }
 
 
-rcp_parameter* rcp_parse_value_update(const char** data, size_t* size)
+rcp_parameter* rcp_parse_value_update(const char** data, size_t* size, rcp_arena* arena, bool borrow)
 {
     if (data == NULL) return NULL;
     if (*data == NULL) return NULL;
@@ -288,13 +260,13 @@ rcp_parameter* rcp_parse_value_update(const char** data, size_t* size)
     // smallest data = 3 bytes (2 byte id, 1 byte typeid)
     if (*size < 3) return NULL;
 
-    rcp_parameter* parameter = _create_parameter_from_data(data, size);
+    rcp_parameter* parameter = _create_parameter_from_data(data, size, arena);
 
     if (parameter &&
             !rcp_parameter_is_type(parameter, DATATYPE_BANG))
     {
         // parse value
-        const char* r_data = rcp_parameter_parse_value(parameter, *data, size);
+        const char* r_data = rcp_parameter_parse_value(parameter, *data, size, borrow);
         if (r_data == NULL)
         {
             rcp_parameter_free(parameter);
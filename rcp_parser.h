@@ -33,6 +33,7 @@ extern "C"{
 
 #include "rcp.h"
 #include "rcp_parameter_type.h"
+#include "rcp_arena.h"
 
 const char* rcp_read_i8(const char* data, size_t* size, int8_t* target);
 const char* rcp_read_u8(const char* data, size_t* size, uint8_t* target);
@@ -42,8 +43,10 @@ const char* rcp_read_i64(const char* data, size_t* size, int64_t* target);
 const char* rcp_read_f32(const char* data, size_t* size, float* target);
 const char* rcp_read_f64(const char* data, size_t* size, double* target);
 
-rcp_parameter* rcp_parse_parameter(const char** data, size_t* size);
-rcp_parameter* rcp_parse_value_update(const char** data, size_t* size);
+// arena: memory of the parsed parameter - NULL: heap
+// borrow: strings reference data - data has to outlive the parameter
+rcp_parameter* rcp_parse_parameter(const char** data, size_t* size, rcp_arena* arena, bool borrow);
+rcp_parameter* rcp_parse_value_update(const char** data, size_t* size, rcp_arena* arena, bool borrow);
 
 #ifdef __cplusplus
 } // extern "C"
@@ -0,0 +1,174 @@
+/*
+********************************************************************
+* RabbitControl - a protocol for remote control.
+* https://rabbitcontrol.cc
+*
+* Copyright (C) 2024, Ingo Randolf
+*
+* This file is part of RabbitControl for C (rcp-c).
+*
+* rcp-c is free software: you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License,
+* or (at your option) any later version.
+*
+* rcp-c is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+* See the GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with rcp-c. If not, see <https://www.gnu.org/licenses/>.
+*********************************************************************
+*/
+
+#include "rcp_pool.h"
+
+#include <string.h>
+#include <stdbool.h>
+
+#include "rcp_memory.h"
+#include "rcp_logging.h"
+
+#if defined(RCP_POOL_DEBUG_LOG) || defined(RCP_ALL_DEBUG)
+#define RCP_POOL_DEBUG(...) RCP_DEBUG(__VA_ARGS__)
+#else
+#define RCP_POOL_DEBUG(...)
+#endif
+
+#if defined(RCP_POOL_MALLOC_DEBUG_LOG) || defined(RCP_ALL_DEBUG)
+#define RCP_POOL_MALLOC_DEBUG(...) RCP_DEBUG(__VA_ARGS__)
+#else
+#define RCP_POOL_MALLOC_DEBUG(...)
+#endif
+
+typedef struct rcp_pool_slab rcp_pool_slab;
+typedef struct rcp_pool_item rcp_pool_item;
+
+struct rcp_pool_slab
+{
+    rcp_pool_slab* next;
+    size_t count;
+    // items follow
+};
+
+struct rcp_pool_item
+{
+    rcp_pool_item* next;
+};
+
+struct rcp_pool
+{
+    rcp_pool_slab* slabs;
+    rcp_pool_item* free_items;
+
+    size_t item_size;
+    size_t next_slab_count;
+};
+
+// align to pointer size
+#define RCP_POOL_ALIGN(x) (((x) + sizeof(void*) - 1) & ~(sizeof(void*) - 1))
+
+
+rcp_pool* rcp_pool_create(size_t item_size, size_t first_slab_count)
+{
+    rcp_pool* pool = (rcp_pool*)RCP_CALLOC(1, sizeof(rcp_pool));
+
+    if (pool != NULL)
+    {
+        RCP_POOL_MALLOC_DEBUG("*** pool: %p\n", pool);
+
+        if (item_size < sizeof(rcp_pool_item))
+        {
+            item_size = sizeof(rcp_pool_item);
+        }
+
+        pool->item_size = RCP_POOL_ALIGN(item_size);
+        pool->next_slab_count = first_slab_count > 0 ? first_slab_count : 1;
+    }
+    else
+    {
+        RCP_ERROR("could not malloc pool\n");
+    }
+
+    return pool;
+}
+
+void rcp_pool_free(rcp_pool* pool)
+{
+    if (pool == NULL) return;
+
+    rcp_pool_slab* slab = pool->slabs;
+    rcp_pool_slab* next;
+    while (slab)
+    {
+        next = slab->next;
+
+        RCP_POOL_MALLOC_DEBUG("+++ pool slab: %p\n", slab);
+        RCP_FREE(slab);
+
+        slab = next;
+    }
+
+    RCP_POOL_MALLOC_DEBUG("+++ pool: %p\n", pool);
+    RCP_FREE(pool);
+}
+
+static bool _add_slab(rcp_pool* pool)
+{
+    size_t header_size = RCP_POOL_ALIGN(sizeof(rcp_pool_slab));
+    rcp_pool_slab* slab = (rcp_pool_slab*)RCP_MALLOC(header_size + pool->item_size * pool->next_slab_count);
+
+    if (slab == NULL)
+    {
+        RCP_ERROR("could not malloc pool slab\n");
+        return false;
+    }
+
+    RCP_POOL_MALLOC_DEBUG("*** pool slab: %p (%d)\n", slab, pool->next_slab_count);
+
+    slab->count = pool->next_slab_count;
+    slab->next = pool->slabs;
+    pool->slabs = slab;
+
+    // put all items into free-list
+    char* items = (char*)slab + header_size;
+    for (size_t i = slab->count; i > 0; i--)
+    {
+        rcp_pool_item* item = (rcp_pool_item*)(items + (i - 1) * pool->item_size);
+        item->next = pool->free_items;
+        pool->free_items = item;
+    }
+
+    pool->next_slab_count *= 2;
+
+    return true;
+}
+
+void* rcp_pool_alloc(rcp_pool* pool)
+{
+    if (pool == NULL) return NULL;
+
+    if (pool->free_items == NULL &&
+            !_add_slab(pool))
+    {
+        return NULL;
+    }
+
+    rcp_pool_item* item = pool->free_items;
+    pool->free_items = item->next;
+
+    memset(item, 0, pool->item_size);
+
+    return item;
+}
+
+void rcp_pool_release(rcp_pool* pool, void* item)
+{
+    if (pool == NULL) return;
+    if (item == NULL) return;
+
+    rcp_pool_item* pool_item = (rcp_pool_item*)item;
+    pool_item->next = pool->free_items;
+    pool->free_items = pool_item;
+}
@@ -0,0 +1,54 @@
+/*
+********************************************************************
+* RabbitControl - a protocol for remote control.
+* https://rabbitcontrol.cc
+*
+* Copyright (C) 2024, Ingo Randolf
+*
+* This file is part of RabbitControl for C (rcp-c).
+*
+* rcp-c is free software: you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License,
+* or (at your option) any later version.
+*
+* rcp-c is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+* See the GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with rcp-c. If not, see <https://www.gnu.org/licenses/>.
+*********************************************************************
+*/
+
+#ifndef RCP_POOL_H
+#define RCP_POOL_H
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+#include <stddef.h>
+
+//#define RCP_POOL_DEBUG_LOG
+//#define RCP_POOL_MALLOC_DEBUG_LOG
+
+// pool of fixed-size items
+// items are taken from slabs, slab capacity doubles with every new slab
+// released items are kept in a free-list until the pool is freed
+typedef struct rcp_pool rcp_pool;
+
+// create / free
+rcp_pool* rcp_pool_create(size_t item_size, size_t first_slab_count);
+void rcp_pool_free(rcp_pool* pool); // frees all items
+
+// items
+void* rcp_pool_alloc(rcp_pool* pool); // zeroed item
+void rcp_pool_release(rcp_pool* pool, void* item);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // RCP_POOL_H
@@ -0,0 +1,444 @@
+/*
+********************************************************************
+* RabbitControl - a protocol for remote control.
+* https://rabbitcontrol.cc
+*
+* Copyright (C) 2024, Ingo Randolf
+*
+* This file is part of RabbitControl for C (rcp-c).
+*
+* rcp-c is free software: you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License,
+* or (at your option) any later version.
+*
+* rcp-c is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+* See the GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with rcp-c. If not, see <https://www.gnu.org/licenses/>.
+*********************************************************************
+*/
+
+#include "rcp_scanner.h"
+
+#include <string.h>
+
+#include "rcp_types.h"
+#include "rcp_parser.h"
+#include "rcp_string.h"
+#include "rcp_langstr.h"
+#include "rcp_typedefinition.h"
+#include "rcp_logging.h"
+
+#if defined(RCP_SCANNER_DEBUG_LOG) || defined(RCP_ALL_DEBUG)
+#define RCP_SCANNER_DEBUG(...) RCP_DEBUG(__VA_ARGS__)
+#else
+#define RCP_SCANNER_DEBUG(...)
+#endif
+
+
+static const char* _skip(const char* data, size_t* size, size_t count)
+{
+    if (data == NULL) return NULL;
+    if (*size < count) return NULL;
+
+    *size -= count;
+    return data + count;
+}
+
+static const char* _skip_string(const char* data, size_t* size, rcp_string_types type)
+{
+    const char* str = NULL;
+    uint32_t str_len = 0;
+
+    return rcp_read_string_view(data, size, type, &str, &str_len);
+}
+
+// size prefixed data (uint32)
+static const char* _skip_sized(const char* data, size_t* size)
+{
+    int32_t data_size = 0;
+    data = rcp_read_i32(data, size, &data_size);
+
+    return _skip(data, size, (uint32_t)data_size);
+}
+
+// language-code + string - terminated chain
+static const char* _skip_langstr_chain(const char* data, size_t* size, rcp_string_types type)
+{
+    while (data != NULL)
+    {
+        if (*size == 0) return NULL;
+
+        if (*data == RCP_TERMINATOR)
+        {
+            return _skip(data, size, 1);
+        }
+
+        data = _skip(data, size, RCP_LANGUAGE_CODE_SIZE);
+        data = _skip_string(data, size, type);
+    }
+
+    return NULL;
+}
+
+static const char* _skip_value(const char* data, size_t* size, rcp_datatype type_id, uint32_t custom_size)
+{
+    switch (type_id)
+    {
+    case DATATYPE_BOOLEAN:
+    case DATATYPE_INT8:
+    case DATATYPE_UINT8:
+        return _skip(data, size, 1);
+
+    case DATATYPE_INT16:
+    case DATATYPE_UINT16:
+        return _skip(data, size, 2);
+
+    case DATATYPE_INT32:
+    case DATATYPE_UINT32:
+    case DATATYPE_FLOAT32:
+    case DATATYPE_RGB:
+    case DATATYPE_IPV4:
+        return _skip(data, size, 4);
+
+    case DATATYPE_INT64:
+    case DATATYPE_UINT64:
+    case DATATYPE_FLOAT64:
+    case DATATYPE_VECTOR2F32:
+        return _skip(data, size, 8);
+
+    case DATATYPE_STRING:
+        return _skip_string(data, size, LONG_STRING);
+
+    case DATATYPE_ENUM:
+        return _skip_string(data, size, TINY_STRING);
+
+    case DATATYPE_CUSTOMTYPE:
+        return _skip(data, size, custom_size);
+
+    default:
+        // not implemented in parser
+        RCP_SCANNER_DEBUG("scan value - datatype not implemented: %d\n", type_id);
+        return NULL;
+    }
+}
+
+static const char* _skip_type_option(const char* data, size_t* size, rcp_datatype type_id, uint32_t custom_size, uint8_t option)
+{
+    switch (type_id)
+    {
+    case DATATYPE_BOOLEAN:
+    case DATATYPE_IPV4:
+        if (option == RCP_OPTIONS_DEFAULT)
+        {
+            return _skip_value(data, size, type_id, custom_size);
+        }
+        return NULL;
+
+    case DATATYPE_INT8:
+    case DATATYPE_UINT8:
+    case DATATYPE_INT16:
+    case DATATYPE_UINT16:
+    case DATATYPE_INT32:
+    case DATATYPE_UINT32:
+    case DATATYPE_INT64:
+    case DATATYPE_UINT64:
+    case DATATYPE_FLOAT32:
+    case DATATYPE_FLOAT64:
+    case DATATYPE_VECTOR2F32:
+    case DATATYPE_VECTOR2I32:
+    case DATATYPE_VECTOR3F32:
+    case DATATYPE_VECTOR3I32:
+    case DATATYPE_VECTOR4F32:
+    case DATATYPE_VECTOR4I32:
+        switch (option)
+        {
+        case NUMBER_OPTIONS_DEFAULT:
+        case NUMBER_OPTIONS_MINIMUM:
+        case NUMBER_OPTIONS_MAXIMUM:
+        case NUMBER_OPTIONS_MULTIPLEOF:
+            return _skip_value(data, size, type_id, custom_size);
+        case NUMBER_OPTIONS_SCALE:
+            return _skip(data, size, 1);
+        case NUMBER_OPTIONS_UNIT:
+            return _skip_string(data, size, TINY_STRING);
+        }
+        return NULL;
+
+    case DATATYPE_STRING:
+        if (option == STRING_OPTIONS_DEFAULT
+                || option == STRING_OPTIONS_REGULAR_EXPRESSION)
+        {
+            return _skip_string(data, size, LONG_STRING);
+        }
+        return NULL;
+
+    case DATATYPE_ENUM:
+        switch (option)
+        {
+        case ENUM_OPTIONS_DEFAULT:
+            return _skip_string(data, size, TINY_STRING);
+        case ENUM_OPTIONS_MULTISELECT:
+            return _skip(data, size, 1);
+        case ENUM_OPTIONS_ENTRIES:
+        {
+            // tiny strings - terminated by empty string
+            while (data != NULL)
+            {
+                if (*size == 0) return NULL;
+
+                if (*data == RCP_TERMINATOR)
+                {
+                    return _skip(data, size, 1);
+                }
+
+                data = _skip_string(data, size, TINY_STRING);
+            }
+            return NULL;
+        }
+        }
+        return NULL;
+
+    case DATATYPE_CUSTOMTYPE:
+        switch (option)
+        {
+        case CUSTOMTYPE_OPTIONS_DEFAULT:
+            return _skip(data, size, custom_size);
+        case CUSTOMTYPE_OPTIONS_UUID:
+            return _skip(data, size, RCP_CUSTOMTYPE_UUID_LENGTH);
+        case CUSTOMTYPE_OPTIONS_CONFIG:
+            return _skip_sized(data, size);
+        }
+        return NULL;
+
+    default:
+        // like the parser: no options for this datatype
+        return data;
+    }
+}
+
+// parameter: id, typedefinition, options
+static const char* _scan_parameter(const char* data, size_t* size, rcp_scan_info* info)
+{
+    // smallest parameter = 5 bytes (2byte id, 1byte typeid, term, term)
+    if (*size < 5) return NULL;
+
+    uint8_t type_id = 0;
+    uint32_t custom_size = 0;
+
+    data = rcp_read_i16(data, size, &info->id);
+    data = rcp_read_u8(data, size, &type_id);
+    if (data == NULL) return NULL;
+
+    info->type_id = (rcp_datatype)type_id;
+
+    if (info->id == 0
+            || type_id == DATATYPE_INVALID
+            || type_id >= DATATYPE_MAX_)
+    {
+        return NULL;
+    }
+
+    if (type_id == DATATYPE_CUSTOMTYPE)
+    {
+        data = rcp_read_i32(data, size, (int32_t*)&custom_size);
+        if (data == NULL) return NULL;
+    }
+
+    // type-options
+    uint8_t option_prefix = 0;
+    while (true)
+    {
+        data = rcp_read_u8(data, size, &option_prefix);
+        if (data == NULL) return NULL;
+
+        if (option_prefix == RCP_TERMINATOR) break;
+
+        info->has_metadata = true;
+
+        data = _skip_type_option(data, size, info->type_id, custom_size, option_prefix);
+        if (data == NULL) return NULL;
+    }
+
+    // parameter options
+    while (true)
+    {
+        data = rcp_read_u8(data, size, &option_prefix);
+        if (data == NULL) return NULL;
+
+        if (option_prefix == RCP_TERMINATOR) return data;
+
+        info->has_options = true;
+
+        if (option_prefix != PARAMETER_OPTIONS_VALUE)
+        {
+            info->has_metadata = true;
+        }
+
+        switch (option_prefix)
+        {
+        case PARAMETER_OPTIONS_VALUE:
+            data = _skip_value(data, size, info->type_id, custom_size);
+            break;
+        case PARAMETER_OPTIONS_LABEL:
+            data = _skip_langstr_chain(data, size, TINY_STRING);
+            break;
+        case PARAMETER_OPTIONS_DESCRIPTION:
+            data = _skip_langstr_chain(data, size, SHORT_STRING);
+            break;
+        case PARAMETER_OPTIONS_TAGS:
+        case PARAMETER_OPTIONS_USERID:
+            data = _skip_string(data, size, TINY_STRING);
+            break;
+        case PARAMETER_OPTIONS_ORDER:
+            data = _skip(data, size, 4);
+            break;
+        case PARAMETER_OPTIONS_PARENTID:
+            data = _skip(data, size, 2);
+            break;
+        case PARAMETER_OPTIONS_USERDATA:
+            data = _skip_sized(data, size);
+            break;
+        case PARAMETER_OPTIONS_READONLY:
+            data = _skip(data, size, 1);
+            break;
+        default:
+            // widget is not supported
+            RCP_SCANNER_DEBUG("scan parameter - invalid option: %d\n", option_prefix);
+            return NULL;
+        }
+
+        if (data == NULL) return NULL;
+    }
+}
+
+// version, optional application-id, terminator
+static const char* _scan_infodata(const char* data, size_t* size)
+{
+    uint8_t option_prefix = 0;
+
+    data = _skip_string(data, size, TINY_STRING);
+    data = rcp_read_u8(data, size, &option_prefix);
+    if (data == NULL) return NULL;
+
+    if (option_prefix == INFODATA_OPTIONS_APPLICATIONID)
+    {
+        data = _skip_string(data, size, TINY_STRING);
+        data = rcp_read_u8(data, size, &option_prefix);
+        if (data == NULL) return NULL;
+    }
+
+    return option_prefix == RCP_TERMINATOR ? data : NULL;
+}
+
+// UPDATEVALUE: id, mandatory part of datatype, value
+static const char* _scan_value_update(const char* data, size_t* size, rcp_scan_info* info)
+{
+    // smallest data = 3 bytes (2 byte id, 1 byte typeid)
+    if (*size < 3) return NULL;
+
+    uint8_t type_id = 0;
+    uint32_t custom_size = 0;
+
+    data = rcp_read_i16(data, size, &info->id);
+    data = rcp_read_u8(data, size, &type_id);
+    if (data == NULL) return NULL;
+
+    info->type_id = (rcp_datatype)type_id;
+
+    if (info->id == 0) return NULL;
+
+    if (type_id == DATATYPE_BANG) return data;
+
+    if (type_id == DATATYPE_CUSTOMTYPE)
+    {
+        data = rcp_read_i32(data, size, (int32_t*)&custom_size);
+        if (data == NULL) return NULL;
+    }
+
+    info->has_options = true;
+    return _skip_value(data, size, info->type_id, custom_size);
+}
+
+bool rcp_scanner_scan_packet(const char* data, size_t size, rcp_scan_info* info)
+{
+    if (data == NULL) return false;
+    if (info == NULL) return false;
+    if (size < 2) return false;
+
+    memset(info, 0, sizeof(rcp_scan_info));
+
+    const char* start = data;
+    uint8_t command = 0;
+
+    data = rcp_read_u8(data, &size, &command);
+    if (data == NULL) return false;
+
+    if (!RCP_COMMAND_VALID(command))
+    {
+        return false;
+    }
+
+    info->command = (rcp_packet_command)command;
+
+    if (command == COMMAND_UPDATEVALUE)
+    {
+        data = _scan_value_update(data, &size, info);
+        if (data == NULL) return false;
+
+        info->size = data - start;
+        return true;
+    }
+
+    uint8_t option_prefix = 0;
+
+    while (data != NULL)
+    {
+        data = rcp_read_u8(data, &size, &option_prefix);
+        if (data == NULL) return false;
+
+        if (option_prefix == RCP_TERMINATOR)
+        {
+            info->size = data - start;
+            return true;
+        }
+
+        if (option_prefix == PACKET_OPTIONS_TIMESTAMP)
+        {
+            data = _skip(data, &size, 8);
+        }
+        else if (option_prefix == PACKET_OPTIONS_DATA)
+        {
+            switch (command)
+            {
+            case COMMAND_INITIALIZE:
+            case COMMAND_DISCOVER:
+            case COMMAND_REMOVE:
+            case COMMAND_SUBSCRIBE:
+            case COMMAND_UNSUBSCRIBE:
+                // id-data
+                data = rcp_read_i16(data, &size, &info->id);
+                break;
+
+            case COMMAND_INFO:
+                data = _scan_infodata(data, &size);
+                break;
+
+            case COMMAND_UPDATE:
+                data = _scan_parameter(data, &size, info);
+                break;
+
+            default:
+                break;
+            }
+        }
+        // like the parser: unknown options are skipped
+    }
+
+    RCP_SCANNER_DEBUG("scan packet - invalid packet\n");
+    return false;
+}
@@ -0,0 +1,59 @@
+/*
+********************************************************************
+* RabbitControl - a protocol for remote control.
+* https://rabbitcontrol.cc
+*
+* Copyright (C) 2024, Ingo Randolf
+*
+* This file is part of RabbitControl for C (rcp-c).
+*
+* rcp-c is free software: you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License,
+* or (at your option) any later version.
+*
+* rcp-c is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+* See the GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with rcp-c. If not, see <https://www.gnu.org/licenses/>.
+*********************************************************************
+*/
+#ifndef RCP_SCANNER_H
+#define RCP_SCANNER_H
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "rcp.h"
+
+//#define RCP_SCANNER_DEBUG_LOG
+
+// walks the structure of one packet without creating any objects
+// used to find packet boundaries and to decide whether a packet
+// needs to be parsed at all
+typedef struct rcp_scan_info
+{
+    rcp_packet_command command;
+    int16_t id; // parameter id or id-data - 0 if none
+    rcp_datatype type_id; // datatype of parameter - DATATYPE_INVALID if none
+    bool has_options; // parameter has options (UPDATEVALUE: a value)
+    bool has_metadata; // parameter has type-options or options other than value
+    size_t size; // size of packet including command and terminator
+} rcp_scan_info;
+
+// returns false if data does not start with a complete and valid packet
+bool rcp_scanner_scan_packet(const char* data, size_t size, rcp_scan_info* info);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif
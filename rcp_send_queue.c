@@ -0,0 +1,490 @@
+/*
+********************************************************************
+* RabbitControl - a protocol for remote control.
+* https://rabbitcontrol.cc
+*
+* Copyright (C) 2024, Ingo Randolf
+*
+* This file is part of RabbitControl for C (rcp-c).
+*
+* rcp-c is free software: you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License,
+* or (at your option) any later version.
+*
+* rcp-c is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+* See the GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with rcp-c. If not, see <https://www.gnu.org/licenses/>.
+*********************************************************************
+*/
+
+#include "rcp_send_queue.h"
+
+#include <string.h>
+#include <stdint.h>
+
+#include "rcp_memory.h"
+#include "rcp_logging.h"
+#include "rcp_scanner.h"
+
+#if defined(RCP_SEND_QUEUE_DEBUG_LOG) || defined(RCP_ALL_DEBUG)
+#define RCP_SEND_QUEUE_DEBUG(...) RCP_DEBUG(__VA_ARGS__)
+#else
+#define RCP_SEND_QUEUE_DEBUG(...)
+#endif
+
+#if defined(RCP_SEND_QUEUE_MALLOC_DEBUG_LOG) || defined(RCP_ALL_DEBUG)
+#define RCP_SEND_QUEUE_MALLOC_DEBUG(...) RCP_DEBUG(__VA_ARGS__)
+#else
+#define RCP_SEND_QUEUE_MALLOC_DEBUG(...)
+#endif
+
+// bits per parameter id for coalescing
+#define RCP_SEND_QUEUE_ID_BITS ((size_t)INT16_MAX + 1)
+
+typedef struct rcp_send_queue_entry rcp_send_queue_entry;
+
+// one packet in the queue
+struct rcp_send_queue_entry
+{
+    size_t size;
+    int16_t id;
+    rcp_packet_command command;
+    bool value; // only the value of a parameter
+    bool drop;
+};
+
+struct rcp_send_queue
+{
+    // pending bytes: data[head] - data[tail]
+    char* data;
+    size_t data_size;
+    size_t head;
+    size_t tail;
+
+    // pending packets: entries[entry_head] - entries[entry_tail]
+    rcp_send_queue_entry* entries;
+    size_t entries_size;
+    size_t entry_head;
+    size_t entry_tail;
+
+    // bytes of the first packet already consumed
+    size_t sent;
+
+    // coalesce: later value of id queued - any command / UPDATE
+    // allocated on first use - all bits are cleared after use
+    uint8_t* later_value;
+    uint8_t* later_update;
+};
+
+
+rcp_send_queue* rcp_send_queue_create()
+{
+    rcp_send_queue* queue = (rcp_send_queue*)RCP_CALLOC(1, sizeof(rcp_send_queue));
+
+    if (queue != NULL)
+    {
+        RCP_SEND_QUEUE_MALLOC_DEBUG("*** send queue: %p\n", queue);
+    }
+    else
+    {
+        RCP_ERROR("could not alloc send queue\n");
+    }
+
+    return queue;
+}
+
+void rcp_send_queue_free(rcp_send_queue* queue)
+{
+    if (queue == NULL) return;
+
+    if (queue->data != NULL)
+    {
+        RCP_SEND_QUEUE_MALLOC_DEBUG("+++ send queue data: %p\n", queue->data);
+        RCP_FREE(queue->data);
+    }
+
+    if (queue->entries != NULL)
+    {
+        RCP_SEND_QUEUE_MALLOC_DEBUG("+++ send queue entries: %p\n", queue->entries);
+        RCP_FREE(queue->entries);
+    }
+
+    if (queue->later_value != NULL)
+    {
+        RCP_SEND_QUEUE_MALLOC_DEBUG("+++ send queue coalesce bits: %p\n", queue->later_value);
+        RCP_FREE(queue->later_value);
+    }
+
+    RCP_SEND_QUEUE_MALLOC_DEBUG("+++ send queue: %p\n", queue);
+    RCP_FREE(queue);
+}
+
+// move pending data and entries to the front
+static void _compact(rcp_send_queue* queue)
+{
+    if (queue->head > 0)
+    {
+        memmove(queue->data, queue->data + queue->head, queue->tail - queue->head);
+        queue->tail -= queue->head;
+        queue->head = 0;
+    }
+
+    if (queue->entry_head > 0)
+    {
+        memmove(queue->entries,
+                queue->entries + queue->entry_head,
+                (queue->entry_tail - queue->entry_head) * sizeof(rcp_send_queue_entry));
+        queue->entry_tail -= queue->entry_head;
+        queue->entry_head = 0;
+    }
+}
+
+static bool _reserve_entry(rcp_send_queue* queue)
+{
+    if (queue->entry_tail < queue->entries_size)
+    {
+        return true;
+    }
+
+    _compact(queue);
+
+    if (queue->entry_tail < queue->entries_size)
+    {
+        return true;
+    }
+
+    size_t new_size = queue->entries_size > 0 ? queue->entries_size * 2 : 32;
+    rcp_send_queue_entry* entries = (rcp_send_queue_entry*)RCP_REALLOC(queue->entries, new_size * sizeof(rcp_send_queue_entry));
+    if (entries == NULL)
+    {
+        RCP_ERROR("could not grow send queue entries\n");
+        return false;
+    }
+
+    RCP_SEND_QUEUE_MALLOC_DEBUG("*** send queue entries: %p\n", entries);
+
+    queue->entries = entries;
+    queue->entries_size = new_size;
+
+    return true;
+}
+
+static bool _reserve_data(rcp_send_queue* queue, size_t size)
+{
+    if (queue->data_size - queue->tail >= size)
+    {
+        return true;
+    }
+
+    _compact(queue);
+
+    if (queue->data_size - queue->tail >= size)
+    {
+        return true;
+    }
+
+    size_t new_size = queue->data_size > 0 ? queue->data_size * 2 : 256;
+    if (new_size < queue->tail + size)
+    {
+        new_size = queue->tail + size;
+    }
+
+    char* data = (char*)RCP_REALLOC(queue->data, new_size);
+    if (data == NULL)
+    {
+        RCP_ERROR("could not grow send queue data\n");
+        return false;
+    }
+
+    RCP_SEND_QUEUE_MALLOC_DEBUG("*** send queue data: %p\n", data);
+
+    queue->data = data;
+    queue->data_size = new_size;
+
+    return true;
+}
+
+bool rcp_send_queue_push(rcp_send_queue* queue, const char* data, size_t size)
+{
+    if (queue == NULL) return false;
+    if (data == NULL) return false;
+    if (size == 0) return true;
+
+    if (!_reserve_data(queue, size))
+    {
+        return false;
+    }
+
+    memcpy(queue->data + queue->tail, data, size);
+    queue->tail += size;
+
+    // one entry per packet
+    while (size > 0)
+    {
+        if (!_reserve_entry(queue))
+        {
+            if (queue->entry_tail == queue->entry_head)
+            {
+                queue->tail -= size;
+                return false;
+            }
+
+            // keep the data - the rest belongs to the last entry
+            queue->entries[queue->entry_tail - 1].size += size;
+            queue->entries[queue->entry_tail - 1].value = false;
+            queue->entries[queue->entry_tail - 1].command = COMMAND_INVALID;
+            return false;
+        }
+
+        rcp_send_queue_entry* entry = &queue->entries[queue->entry_tail];
+        memset(entry, 0, sizeof(rcp_send_queue_entry));
+
+        rcp_scan_info info;
+        if (rcp_scanner_scan_packet(data, size, &info))
+        {
+            entry->size = info.size;
+            entry->id = info.id;
+            entry->command = info.command;
+            entry->value = (info.command == COMMAND_UPDATE || info.command == COMMAND_UPDATEVALUE)
+                    && info.has_options
+                    && !info.has_metadata
+                    && info.id > 0;
+        }
+        else
+        {
+            // not a packet we know - keep the rest as it is
+            entry->size = size;
+            entry->command = COMMAND_INVALID;
+        }
+
+        queue->entry_tail++;
+
+        data += entry->size;
+        size -= entry->size;
+    }
+
+    return true;
+}
+
+size_t rcp_send_queue_get_size(rcp_send_queue* queue)
+{
+    if (queue == NULL) return 0;
+
+    return queue->tail - queue->head;
+}
+
+const char* rcp_send_queue_peek(rcp_send_queue* queue, size_t max_size, size_t* size)
+{
+    if (size == NULL) return NULL;
+
+    *size = 0;
+
+    if (queue == NULL) return NULL;
+    if (queue->entry_head == queue->entry_tail) return NULL;
+
+    // rest of first packet
+    size_t peek_size = queue->entries[queue->entry_head].size - queue->sent;
+
+    for (size_t i = queue->entry_head + 1; i < queue->entry_tail; i++)
+    {
+        if (max_size > 0 &&
+                peek_size + queue->entries[i].size > max_size)
+        {
+            break;
+        }
+
+        peek_size += queue->entries[i].size;
+    }
+
+    *size = peek_size;
+    return queue->data + queue->head;
+}
+
+void rcp_send_queue_consume(rcp_send_queue* queue, size_t size)
+{
+    if (queue == NULL) return;
+
+    if (size > queue->tail - queue->head)
+    {
+        size = queue->tail - queue->head;
+    }
+
+    queue->head += size;
+
+    while (size > 0)
+    {
+        size_t rest = queue->entries[queue->entry_head].size - queue->sent;
+        if (size < rest)
+        {
+            queue->sent += size;
+            break;
+        }
+
+        size -= rest;
+        queue->sent = 0;
+        queue->entry_head++;
+    }
+
+    if (queue->entry_head == queue->entry_tail)
+    {
+        queue->head = 0;
+        queue->tail = 0;
+        queue->entry_head = 0;
+        queue->entry_tail = 0;
+        queue->sent = 0;
+    }
+}
+
+// first entry which may be dropped - a started packet must be sent completely
+static size_t _first_droppable(rcp_send_queue* queue)
+{
+    return queue->sent > 0 ? queue->entry_head + 1 : queue->entry_head;
+}
+
+// remove entries marked with drop and their data
+static size_t _remove_dropped(rcp_send_queue* queue)
+{
+    size_t first = _first_droppable(queue);
+
+    // data of first droppable entry
+    size_t read = queue->head;
+    if (first > queue->entry_head)
+    {
+        read += queue->entries[queue->entry_head].size - queue->sent;
+    }
+
+    size_t write = read;
+    size_t write_entry = first;
+    size_t dropped = 0;
+
+    for (size_t i = first; i < queue->entry_tail; i++)
+    {
+        rcp_send_queue_entry* entry = &queue->entries[i];
+
+        if (entry->drop)
+        {
+            dropped += entry->size;
+        }
+        else
+        {
+            if (write != read)
+            {
+                memmove(queue->data + write, queue->data + read, entry->size);
+            }
+            write += entry->size;
+
+            queue->entries[write_entry++] = *entry;
+        }
+
+        read += entry->size;
+    }
+
+    queue->tail = write;
+    queue->entry_tail = write_entry;
+
+    if (queue->entry_head == queue->entry_tail)
+    {
+        queue->head = 0;
+        queue->tail = 0;
+        queue->entry_head = 0;
+        queue->entry_tail = 0;
+    }
+
+    return dropped;
+}
+
+size_t rcp_send_queue_coalesce(rcp_send_queue* queue)
+{
+    if (queue == NULL) return 0;
+
+    size_t first = _first_droppable(queue);
+    if (queue->entry_tail - first < 2) return 0;
+
+    if (queue->later_value == NULL)
+    {
+        queue->later_value = (uint8_t*)RCP_CALLOC(2, RCP_SEND_QUEUE_ID_BITS / 8);
+        if (queue->later_value == NULL)
+        {
+            RCP_ERROR("could not alloc coalesce bits\n");
+            return 0;
+        }
+
+        RCP_SEND_QUEUE_MALLOC_DEBUG("*** send queue coalesce bits: %p\n", queue->later_value);
+
+        queue->later_update = queue->later_value + RCP_SEND_QUEUE_ID_BITS / 8;
+    }
+
+    uint8_t* later_value = queue->later_value;
+    uint8_t* later_update = queue->later_update;
+    bool any_dropped = false;
+
+    for (size_t i = queue->entry_tail; i > first; i--)
+    {
+        rcp_send_queue_entry* entry = &queue->entries[i - 1];
+        entry->drop = false;
+
+        if (!entry->value) continue;
+
+        size_t byte = (size_t)entry->id / 8;
+        uint8_t bit = (uint8_t)(1 << (entry->id % 8));
+
+        // UPDATE creates the parameter on a new client - only an UPDATE replaces it
+        if ((entry->command == COMMAND_UPDATEVALUE && (later_value[byte] & bit)) ||
+                (entry->command == COMMAND_UPDATE && (later_update[byte] & bit)))
+        {
+            entry->drop = true;
+            any_dropped = true;
+            continue;
+        }
+
+        later_value[byte] |= bit;
+        if (entry->command == COMMAND_UPDATE)
+        {
+            later_update[byte] |= bit;
+        }
+    }
+
+    // clear the bits we set - cheaper than clearing all of them
+    for (size_t i = first; i < queue->entry_tail; i++)
+    {
+        rcp_send_queue_entry* entry = &queue->entries[i];
+        if (entry->value)
+        {
+            later_value[(size_t)entry->id / 8] = 0;
+            later_update[(size_t)entry->id / 8] = 0;
+        }
+    }
+
+    if (!any_dropped) return 0;
+
+    size_t dropped = _remove_dropped(queue);
+
+    RCP_SEND_QUEUE_DEBUG("coalesced %d bytes\n", dropped);
+
+    return dropped;
+}
+
+size_t rcp_send_queue_drop_state(rcp_send_queue* queue)
+{
+    if (queue == NULL) return 0;
+
+    for (size_t i = _first_droppable(queue); i < queue->entry_tail; i++)
+    {
+        rcp_send_queue_entry* entry = &queue->entries[i];
+
+        // INITIALIZE ends a response the client waits for - keep it
+        entry->drop = entry->command == COMMAND_UPDATE ||
+                entry->command == COMMAND_UPDATEVALUE;
+    }
+
+    size_t dropped = _remove_dropped(queue);
+
+    RCP_SEND_QUEUE_DEBUG("dropped %d bytes\n", dropped);
+
+    return dropped;
+}
@@ -0,0 +1,72 @@
+/*
+********************************************************************
+* RabbitControl - a protocol for remote control.
+* https://rabbitcontrol.cc
+*
+* Copyright (C) 2024, Ingo Randolf
+*
+* This file is part of RabbitControl for C (rcp-c).
+*
+* rcp-c is free software: you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License,
+* or (at your option) any later version.
+*
+* rcp-c is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+* See the GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with rcp-c. If not, see <https://www.gnu.org/licenses/>.
+*********************************************************************
+*/
+
+#ifndef RCP_SEND_QUEUE_H
+#define RCP_SEND_QUEUE_H
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+#include <stddef.h>
+#include <stdbool.h>
+
+//#define RCP_SEND_QUEUE_DEBUG_LOG
+//#define RCP_SEND_QUEUE_MALLOC_DEBUG_LOG
+
+// outbound bytes of one client which were not yet accepted by the transporter
+// data is split into packets with the scanner so pending values can be coalesced
+typedef struct rcp_send_queue rcp_send_queue;
+
+// create / free
+rcp_send_queue* rcp_send_queue_create();
+void rcp_send_queue_free(rcp_send_queue* queue);
+
+// append data - copied
+bool rcp_send_queue_push(rcp_send_queue* queue, const char* data, size_t size);
+
+// pending bytes
+size_t rcp_send_queue_get_size(rcp_send_queue* queue);
+
+// pending data from the front ending on a packet boundary
+// up to max_size bytes (at least one packet) - 0: all
+const char* rcp_send_queue_peek(rcp_send_queue* queue, size_t max_size, size_t* size);
+
+// remove size bytes from the front (accepted by the transporter)
+void rcp_send_queue_consume(rcp_send_queue* queue, size_t size);
+
+// drop value updates which are superseded by a later value of the same parameter
+// returns number of bytes dropped
+size_t rcp_send_queue_coalesce(rcp_send_queue* queue);
+
+// drop UPDATE and UPDATEVALUE packets not yet started - INITIALIZE is kept
+// used before a resync which resends the state
+// returns number of bytes dropped
+size_t rcp_send_queue_drop_state(rcp_send_queue* queue);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // RCP_SEND_QUEUE_H
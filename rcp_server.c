@@ -25,6 +25,7 @@
 #include "rcp_server.h"
 
 #include <string.h>
+#include <stdint.h>
 
 #include "rcp_memory.h"
 #include "rcp_logging.h"
@@ -32,6 +33,10 @@
 #include "rcp_infodata.h"
 #include "rcp_manager.h"
 #include "rcp_parameter.h"
+#include "rcp_pool.h"
+#include "rcp_arena.h"
+#include "rcp_scanner.h"
+#include "rcp_send_queue.h"
 
 #define RCP_SERVER_SETUP_PARAMETER(p, m) \
     rcp_parameter_set_label(RCP_PARAMETER(p), label);\
@@ -51,39 +56,990 @@
 #define RCP_SERVER_MALLOC_DEBUG(...)
 #endif
 
+// bits of all possible parameter ids
+#define RCP_SERVER_ID_WORDS (65536 / 32)
+
 typedef struct transporter_list_item transporter_list_item;
+typedef struct client_list_item client_list_item;
+
+struct rcp_server
+{
+    rcp_manager* manager;
+    transporter_list_item* transporters;
+    rcp_pool* transporter_pool;
+    char* applicationId;
+
+    // clients with state - subscribed clients or all clients if they have a queue
+    // the list is hashed by client for lookups
+    client_list_item* clients;
+    client_list_item** client_buckets;
+    size_t client_bucket_count;
+    size_t client_count;
+    rcp_pool* client_pool;
+    size_t subscribed_count; // clients with subscriptions
+    size_t structure_version; // changes with the parameter tree - subscribed ids are rebuilt
+    size_t client_queue_size; // outbound bytes per client - 0: send directly
+    rcp_server_transporter* receive_transporter; // transporter of data being received
+
+    // clients sent to one by one - excluded from sendToAllExcept
+    void** excluded;
+    size_t excluded_size;
+
+    // packets of data sent to all - for filtering by subscriptions
+    rcp_scan_info* scan_infos;
+    size_t scan_infos_size;
+    char* filter_buffer;
+    size_t filter_buffer_size;
+
+    // reused for parsing - NULL while in use
+    rcp_packet* receive_packet;
+
+#ifdef RCP_USE_ARENA
+    // memory of parsed packets - NULL while in use
+    rcp_arena* arena;
+#endif
+};
+
+struct transporter_list_item
+{
+    transporter_list_item* next;
+    rcp_server_transporter* transporter;
+};
+
+struct client_list_item
+{
+    client_list_item* next;
+    client_list_item* bucket_next;
+    void* client;
+    rcp_server_transporter* transporter; // NULL: not received through a transporter
+
+    // subscribed groups - empty: all parameters
+    int16_t* subscriptions;
+    size_t subscription_count;
+    size_t subscription_size;
+    uint32_t* subscribed_ids; // bits of parameters in subscribed groups and of unknown ids
+    size_t subscribed_version; // structure version of subscribed ids - 0: rebuild
+
+    // what the client requested - resent on resync
+    bool initialized; // INITIALIZE without id: all parameters
+    int16_t* discovered; // ids of DISCOVER and INITIALIZE with id
+    size_t discovered_count;
+    size_t discovered_size;
+
+    // outbound data not yet accepted by the transporters
+    rcp_send_queue* queue;
+    bool resync; // state was dropped - resent from next update on
+    bool resyncing; // state is being queued
+
+    // parameters to resend - sent while the queue drains
+    int16_t* resync_ids;
+    size_t resync_count;
+    size_t resync_size;
+    size_t resync_next;
+};
+
+
+
+static inline void _send_to_transporters(rcp_server* server, const char* data, size_t size, void* client)
+{
+    transporter_list_item* le = server->transporters;
+    while (le)
+    {
+        le->transporter->sendToOne(le->transporter,
+                                   data,
+                                   size,
+                                   client);
+
+        le = le->next;
+    }
+}
+
+// returns the number of bytes accepted by all transporters
+static size_t _try_send_to_transporters(rcp_server* server, const char* data, size_t size, void* client)
+{
+    size_t accepted = size;
+
+    transporter_list_item* le = server->transporters;
+    while (le)
+    {
+        if (le->transporter->trySendToOne != NULL)
+        {
+            size_t transporter_accepted = le->transporter->trySendToOne(le->transporter,
+                                                                        data,
+                                                                        size,
+                                                                        client);
+            if (transporter_accepted < accepted)
+            {
+                accepted = transporter_accepted;
+            }
+        }
+        else
+        {
+            le->transporter->sendToOne(le->transporter,
+                                       data,
+                                       size,
+                                       client);
+        }
+
+        le = le->next;
+    }
+
+    return accepted;
+}
+
+// clients
+
+static inline size_t _client_bucket(size_t bucket_count, void* client)
+{
+    uintptr_t key = (uintptr_t)client;
+    key ^= key >> 16;
+    key *= 0x45d9f3b;
+    key ^= key >> 16;
+
+    return (size_t)key & (bucket_count - 1);
+}
+
+// keep about one client per bucket
+static void _grow_client_buckets(rcp_server* server)
+{
+    size_t bucket_count = server->client_bucket_count > 0 ? server->client_bucket_count * 2 : 8;
+    client_list_item** buckets = (client_list_item**)RCP_CALLOC(bucket_count, sizeof(client_list_item*));
+    if (buckets == NULL)
+    {
+        // keep the old buckets - lookups get slower
+        RCP_ERROR("could not grow client buckets\n");
+        return;
+    }
+
+    RCP_SERVER_MALLOC_DEBUG("*** client buckets: %p\n", buckets);
+
+    client_list_item* item = server->clients;
+    while (item != NULL)
+    {
+        size_t bucket = _client_bucket(bucket_count, item->client);
+        item->bucket_next = buckets[bucket];
+        buckets[bucket] = item;
+
+        item = item->next;
+    }
+
+    if (server->client_buckets != NULL)
+    {
+        RCP_SERVER_MALLOC_DEBUG("+++ client buckets: %p\n", server->client_buckets);
+        RCP_FREE(server->client_buckets);
+    }
+
+    server->client_buckets = buckets;
+    server->client_bucket_count = bucket_count;
+}
+
+static client_list_item* _get_client(rcp_server* server, void* client, bool create)
+{
+    if (server->client_count > 0)
+    {
+        client_list_item* item = server->client_buckets[_client_bucket(server->client_bucket_count, client)];
+        while (item != NULL)
+        {
+            if (item->client == client)
+            {
+                return item;
+            }
+            item = item->bucket_next;
+        }
+    }
+
+    if (!create)
+    {
+        return NULL;
+    }
+
+    if (server->client_count >= server->client_bucket_count)
+    {
+        _grow_client_buckets(server);
+        if (server->client_buckets == NULL) return NULL;
+    }
+
+    if (server->client_pool == NULL)
+    {
+        server->client_pool = rcp_pool_create(sizeof(client_list_item), 8);
+    }
+
+    client_list_item* item = rcp_pool_alloc(server->client_pool);
+    if (item == NULL)
+    {
+        RCP_ERROR("could not alloc client list item\n");
+        return NULL;
+    }
+
+    RCP_SERVER_MALLOC_DEBUG("*** client list item: %p\n", item);
+
+    item->client = client;
+    item->transporter = server->receive_transporter;
+
+    item->next = server->clients;
+    server->clients = item;
+
+    size_t bucket = _client_bucket(server->client_bucket_count, client);
+    item->bucket_next = server->client_buckets[bucket];
+    server->client_buckets[bucket] = item;
+
+    server->client_count++;
+
+    return item;
+}
+
+static void _free_client(rcp_server* server, client_list_item* item)
+{
+    if (item->subscription_count > 0)
+    {
+        server->subscribed_count--;
+    }
+
+    if (item->subscriptions != NULL)
+    {
+        RCP_SERVER_MALLOC_DEBUG("+++ subscriptions: %p\n", item->subscriptions);
+        RCP_FREE(item->subscriptions);
+    }
+
+    if (item->subscribed_ids != NULL)
+    {
+        RCP_SERVER_MALLOC_DEBUG("+++ subscribed ids: %p\n", item->subscribed_ids);
+        RCP_FREE(item->subscribed_ids);
+    }
+
+    if (item->discovered != NULL)
+    {
+        RCP_SERVER_MALLOC_DEBUG("+++ discovered: %p\n", item->discovered);
+        RCP_FREE(item->discovered);
+    }
+
+    if (item->resync_ids != NULL)
+    {
+        RCP_SERVER_MALLOC_DEBUG("+++ resync ids: %p\n", item->resync_ids);
+        RCP_FREE(item->resync_ids);
+    }
+
+    rcp_send_queue_free(item->queue);
+
+    RCP_SERVER_MALLOC_DEBUG("+++ client list item: %p\n", item);
+    rcp_pool_release(server->client_pool, item);
+}
+
+// add id to a list of a client if it is not in it
+static bool _add_id(int16_t** ids, size_t* count, size_t* size, int16_t id)
+{
+    for (size_t i = 0; i < *count; i++)
+    {
+        if ((*ids)[i] == id)
+        {
+            return true;
+        }
+    }
+
+    if (*count >= *size)
+    {
+        size_t new_size = *size > 0 ? *size * 2 : 4;
+        int16_t* new_ids = (int16_t*)RCP_REALLOC(*ids, new_size * sizeof(int16_t));
+        if (new_ids == NULL)
+        {
+            RCP_ERROR("could not grow client ids\n");
+            return false;
+        }
+
+        RCP_SERVER_MALLOC_DEBUG("*** client ids: %p\n", new_ids);
+
+        *ids = new_ids;
+        *size = new_size;
+    }
+
+    (*ids)[(*count)++] = id;
+
+    return true;
+}
+
+// unlink client from list and bucket and free it
+static void _remove_client_item(rcp_server* server, client_list_item* item)
+{
+    client_list_item** it = &server->clients;
+    while (*it != item)
+    {
+        it = &(*it)->next;
+    }
+    *it = item->next;
+
+    it = &server->client_buckets[_client_bucket(server->client_bucket_count, item->client)];
+    while (*it != item)
+    {
+        it = &(*it)->bucket_next;
+    }
+    *it = item->bucket_next;
+
+    server->client_count--;
+
+    _free_client(server, item);
+}
+
+// forget client - transporter NULL: of any transporter
+static void _remove_client(rcp_server* server, rcp_server_transporter* transporter, void* client)
+{
+    client_list_item* item = _get_client(server, client, false);
+    if (item != NULL &&
+            (transporter == NULL ||
+             item->transporter == NULL ||
+             item->transporter == transporter))
+    {
+        _remove_client_item(server, item);
+    }
+}
+
+// forget client if nothing is kept for it
+static void _release_client(rcp_server* server, client_list_item* item)
+{
+    if (item->subscription_count == 0 &&
+            server->client_queue_size == 0)
+    {
+        _remove_client_item(server, item);
+    }
+}
+
+// forget all clients of a removed transporter
+static void _remove_transporter_clients(rcp_server* server, rcp_server_transporter* transporter)
+{
+    client_list_item* item = server->clients;
+    while (item != NULL)
+    {
+        client_list_item* next = item->next;
+
+        if (item->transporter == transporter)
+        {
+            _remove_client_item(server, item);
+        }
+
+        item = next;
+    }
+}
+
+// a client starts a new session - a reused client handle does not inherit anything
+static void _reset_client(rcp_server* server, void* client)
+{
+    client_list_item* item = _get_client(server, client, false);
+    if (item == NULL) return;
+
+    if (item->subscription_count > 0)
+    {
+        item->subscription_count = 0;
+        item->subscribed_version = 0;
+        server->subscribed_count--;
+    }
+
+    item->initialized = false;
+    item->discovered_count = 0;
+
+    rcp_send_queue_consume(item->queue, rcp_send_queue_get_size(item->queue));
+    item->resync = false;
+    item->resync_count = 0;
+    item->resync_next = 0;
+
+    _release_client(server, item);
+}
+
+// called from transporter - remember which transporter a client belongs to
+static void _transporter_received(rcp_server_transporter* transporter, const char* data, size_t size, void* client)
+{
+    rcp_server* server = transporter->server;
+    if (server == NULL) return;
+
+    rcp_server_transporter* receive_transporter = server->receive_transporter;
+    server->receive_transporter = transporter;
+
+    rcp_server_receive_cb(server, data, size, client);
+
+    server->receive_transporter = receive_transporter;
+}
+
+// transporter lost a client
+static void _transporter_disconnected(rcp_server_transporter* transporter, void* client)
+{
+    if (transporter->server == NULL) return;
+
+    _remove_client(transporter->server, transporter, client);
+}
+
+// client queues
+
+// send queued data until a transporter does not accept all of it
+static void _flush_client(rcp_server* server, client_list_item* item)
+{
+    size_t max_frame_size = rcp_manager_get_max_frame_size(server->manager);
+
+    while (rcp_send_queue_get_size(item->queue) > 0)
+    {
+        size_t size = 0;
+        const char* data = rcp_send_queue_peek(item->queue, max_frame_size, &size);
+
+        size_t accepted = _try_send_to_transporters(server, data, size, item->client);
+
+        rcp_send_queue_consume(item->queue, accepted);
+
+        if (accepted < size)
+        {
+            break;
+        }
+    }
+}
+
+// keep queue of client within the budget
+// 1. coalesce values of the same parameter
+// 2. drop all pending state - it is resent on next update
+static void _limit_client_queue(rcp_server* server, client_list_item* item)
+{
+    if (item->resyncing) return;
+
+    size_t size = rcp_send_queue_get_size(item->queue);
+    if (size <= server->client_queue_size)
+    {
+        return;
+    }
+
+    size -= rcp_send_queue_coalesce(item->queue);
+    if (size <= server->client_queue_size)
+    {
+        return;
+    }
+
+    if (!item->resync &&
+            item->resync_next >= item->resync_count)
+    {
+        RCP_INFO("client queue full - resync client\n");
+    }
+
+    rcp_send_queue_drop_state(item->queue);
+
+    // dropped state may be of parameters already resent - start over
+    item->resync = true;
+}
+
+static void _queue_to_client(rcp_server* server, client_list_item* item, const char* data, size_t size)
+{
+    if (item->queue == NULL)
+    {
+        item->queue = rcp_send_queue_create();
+        if (item->queue == NULL)
+        {
+            _send_to_transporters(server, data, size, item->client);
+            return;
+        }
+    }
+
+    if (rcp_send_queue_get_size(item->queue) == 0)
+    {
+        // nothing pending - try to send directly
+        size_t accepted = _try_send_to_transporters(server, data, size, item->client);
+        if (accepted < size)
+        {
+            rcp_send_queue_push(item->queue, data, size);
+            rcp_send_queue_consume(item->queue, accepted);
+        }
+        return;
+    }
+
+    rcp_send_queue_push(item->queue, data, size);
+    _limit_client_queue(server, item);
+    _flush_client(server, item);
+}
+
+static inline void _set_id_bit(uint32_t* bits, int16_t id)
+{
+    uint16_t key = (uint16_t)id;
+    bits[key >> 5] |= (uint32_t)1 << (key & 31);
+}
+
+static inline void _clear_id_bit(uint32_t* bits, int16_t id)
+{
+    uint16_t key = (uint16_t)id;
+    bits[key >> 5] &= ~((uint32_t)1 << (key & 31));
+}
+
+static void _set_subtree_bits(uint32_t* bits, rcp_parameter* parameter)
+{
+    _set_id_bit(bits, rcp_parameter_get_id(parameter));
+
+    if (rcp_parameter_is_group(parameter))
+    {
+        rcp_parameter_list* child = rcp_group_get_children(RCP_GROUP_PARAMETER(parameter));
+        while (child != NULL)
+        {
+            _set_subtree_bits(bits, child->parameter);
+            child = child->next;
+        }
+    }
+}
+
+// rebuild subscribed ids of client after its subscriptions or the parameter tree changed
+// ids the manager does not know are not filtered
+static void _update_subscribed_ids(rcp_server* server, client_list_item* item)
+{
+    if (item->subscribed_version == server->structure_version) return;
+
+    if (item->subscribed_ids == NULL)
+    {
+        item->subscribed_ids = (uint32_t*)RCP_MALLOC(RCP_SERVER_ID_WORDS * sizeof(uint32_t));
+        if (item->subscribed_ids == NULL)
+        {
+            RCP_ERROR("could not alloc subscribed ids\n");
+            return;
+        }
+
+        RCP_SERVER_MALLOC_DEBUG("*** subscribed ids: %p\n", item->subscribed_ids);
+    }
+
+    memset(item->subscribed_ids, 0xff, RCP_SERVER_ID_WORDS * sizeof(uint32_t));
+    item->subscribed_version = server->structure_version;
+
+    for (size_t i = 0; i < item->subscription_count; i++)
+    {
+        if (item->subscriptions[i] == 0)
+        {
+            // root group
+            return;
+        }
+    }
+
+    rcp_parameter_list* pl = rcp_manager_get_paramter_list(server->manager);
+    while (pl != NULL)
+    {
+        _clear_id_bit(item->subscribed_ids, rcp_parameter_get_id(pl->parameter));
+        pl = pl->next;
+    }
+
+    for (size_t i = 0; i < item->subscription_count; i++)
+    {
+        rcp_parameter* parameter = rcp_manager_get_parameter(server->manager, item->subscriptions[i]);
+        if (parameter != NULL)
+        {
+            _set_subtree_bits(item->subscribed_ids, parameter);
+        }
+    }
+}
+
+// parameter or one of its groups is subscribed
+static bool _is_subscribed(rcp_server* server, client_list_item* item, int16_t id)
+{
+    _update_subscribed_ids(server, item);
+
+    if (item->subscribed_ids == NULL)
+    {
+        return true;
+    }
+
+    uint16_t key = (uint16_t)id;
+    return (item->subscribed_ids[key >> 5] & ((uint32_t)1 << (key & 31))) != 0;
+}
+
+// only values are filtered - parameters with metadata and removals reach all clients
+static inline bool _is_value_packet(rcp_scan_info* info)
+{
+    return (info->command == COMMAND_UPDATE ||
+            info->command == COMMAND_UPDATEVALUE) &&
+            !info->has_metadata;
+}
+
+static bool _packet_subscribed(rcp_server* server, client_list_item* item, rcp_scan_info* info)
+{
+    if (!_is_value_packet(info))
+    {
+        return true;
+    }
+
+    return _is_subscribed(server, item, info->id);
+}
+
+// split data into packets
+// returns the number of packets or 0 if data could not be scanned
+static size_t _scan_packets(rcp_server* server, const char* data, size_t size)
+{
+    size_t count = 0;
+
+    while (size > 0)
+    {
+        if (count >= server->scan_infos_size)
+        {
+            size_t new_size = server->scan_infos_size > 0 ? server->scan_infos_size * 2 : 16;
+            rcp_scan_info* infos = (rcp_scan_info*)RCP_REALLOC(server->scan_infos, new_size * sizeof(rcp_scan_info));
+            if (infos == NULL)
+            {
+                RCP_ERROR("could not grow scan infos\n");
+                return 0;
+            }
+
+            RCP_SERVER_MALLOC_DEBUG("*** scan infos: %p\n", infos);
+
+            server->scan_infos = infos;
+            server->scan_infos_size = new_size;
+        }
+
+        rcp_scan_info* info = &server->scan_infos[count];
+        if (!rcp_scanner_scan_packet(data, size, info))
+        {
+            return 0;
+        }
+
+        data += info->size;
+        size -= info->size;
+        count++;
+    }
+
+    return count;
+}
+
+// collect scanned packets of data subscribed by client in the filter buffer
+// returns the filtered size
+static size_t _filter_packets(rcp_server* server, client_list_item* item, const char* data, size_t count)
+{
+    size_t offset = 0;
+    size_t filtered_size = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        rcp_scan_info* info = &server->scan_infos[i];
+
+        if (_packet_subscribed(server, item, info))
+        {
+            if (rcp_packet_reserve_buffer(&server->filter_buffer, &server->filter_buffer_size, filtered_size + info->size))
+            {
+                memcpy(server->filter_buffer + filtered_size, data + offset, info->size);
+                filtered_size += info->size;
+            }
+        }
+
+        offset += info->size;
+    }
+
+    return filtered_size;
+}
+
+static void _rcp_server_send_to_one(rcp_server* server, const char* data, size_t size, void* client)
+{
+    client_list_item* item = _get_client(server, client, false);
+
+    if (server->client_queue_size > 0 &&
+            item != NULL)
+    {
+        _queue_to_client(server, item, data, size);
+        return;
+    }
+
+    _send_to_transporters(server, data, size, client);
+}
+
+// all transporters can send to clients without state
+static bool _can_send_to_all_except(rcp_server* server)
+{
+    transporter_list_item* le = server->transporters;
+    while (le)
+    {
+        if (le->transporter->sendToAllExcept == NULL)
+        {
+            return false;
+        }
+
+        le = le->next;
+    }
+
+    return true;
+}
+
+// send data to clients without state - all clients except the known ones and exclude
+static void _send_to_all_except(rcp_server* server, const char* data, size_t size, void* exclude)
+{
+    size_t count = server->client_count + (exclude != NULL ? 1 : 0);
+    if (count > server->excluded_size)
+    {
+        void** excluded = (void**)RCP_REALLOC(server->excluded, count * sizeof(void*));
+        if (excluded == NULL)
+        {
+            RCP_ERROR("could not grow excluded clients\n");
+            return;
+        }
+
+        RCP_SERVER_MALLOC_DEBUG("*** excluded clients: %p\n", excluded);
+
+        server->excluded = excluded;
+        server->excluded_size = count;
+    }
+
+    count = 0;
+    client_list_item* item = server->clients;
+    while (item != NULL)
+    {
+        server->excluded[count++] = item->client;
+        item = item->next;
+    }
+
+    if (exclude != NULL)
+    {
+        server->excluded[count++] = exclude;
+    }
+
+    transporter_list_item* le = server->transporters;
+    while (le)
+    {
+        le->transporter->sendToAllExcept(le->transporter,
+                                         data,
+                                         size,
+                                         server->excluded,
+                                         count);
+
+        le = le->next;
+    }
+}
+
+// send packets of data to each known client according to its subscriptions
+// clients without subscriptions get all data
+static void _send_to_subscribers(rcp_server* server, const char* data, size_t size, void* exclude)
+{
+    size_t count = server->subscribed_count > 0 ? _scan_packets(server, data, size) : 0;
+
+    // the parameter tree may have changed - not scanned or not only values
+    bool structure = count == 0;
+    for (size_t i = 0; i < count && !structure; i++)
+    {
+        structure = !_is_value_packet(&server->scan_infos[i]);
+    }
+
+    if (structure)
+    {
+        server->structure_version++;
+    }
+
+    client_list_item* item = server->clients;
+    while (item != NULL)
+    {
+        if (item->client == exclude)
+        {
+            item = item->next;
+            continue;
+        }
+
+        if (item->subscription_count == 0 ||
+                count == 0)
+        {
+            // all parameters - or data we can not filter
+            _rcp_server_send_to_one(server, data, size, item->client);
+
+            item = item->next;
+            continue;
+        }
+
+        size_t filtered_size = _filter_packets(server, item, data, count);
+
+        if (filtered_size == size)
+        {
+            _rcp_server_send_to_one(server, data, size, item->client);
+        }
+        else if (filtered_size > 0)
+        {
+            _rcp_server_send_to_one(server, server->filter_buffer, filtered_size, item->client);
+        }
+
+        item = item->next;
+    }
+}
+
+// root group is subscribed
+static bool _subscribed_all(client_list_item* item)
+{
+    for (size_t i = 0; i < item->subscription_count; i++)
+    {
+        if (item->subscriptions[i] == 0)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// group is covered by another subscription
+static bool _subscription_nested(rcp_server* server, client_list_item* item, rcp_parameter* parameter)
+{
+    rcp_group_parameter* parent = rcp_parameter_get_parent(parameter);
+    if (parent == NULL) return false;
+
+    _update_subscribed_ids(server, item);
+
+    return item->subscribed_ids != NULL &&
+            _is_subscribed(server, item, rcp_parameter_get_id(RCP_PARAMETER(parent)));
+}
+
+static void _add_resync_id(client_list_item* item, int16_t id)
+{
+    if (item->resync_count >= item->resync_size)
+    {
+        size_t new_size = item->resync_size > 0 ? item->resync_size * 2 : 16;
+        int16_t* ids = (int16_t*)RCP_REALLOC(item->resync_ids, new_size * sizeof(int16_t));
+        if (ids == NULL)
+        {
+            RCP_ERROR("could not grow resync ids\n");
+            return;
+        }
+
+        RCP_SERVER_MALLOC_DEBUG("*** resync ids: %p\n", ids);
+
+        item->resync_ids = ids;
+        item->resync_size = new_size;
+    }
 
-struct rcp_server
+    item->resync_ids[item->resync_count++] = id;
+}
+
+static rcp_parameter_list* _list_last(rcp_parameter_list* list)
 {
-    rcp_manager* manager;
-    transporter_list_item* transporters;
-    char* applicationId;
-};
+    while (list != NULL &&
+           list->next != NULL)
+    {
+        list = list->next;
+    }
 
-struct transporter_list_item
+    return list;
+}
+
+// parameter and the children of a group in order of creation - groups before their children
+// recursive: also children of child groups
+static void _add_resync_parameter(client_list_item* item, rcp_parameter* parameter, bool recursive)
 {
-    transporter_list_item* next;
-    rcp_server_transporter* transporter;
-};
+    _add_resync_id(item, rcp_parameter_get_id(parameter));
 
+    if (!rcp_parameter_is_group(parameter)) return;
 
+    rcp_parameter_list* child = _list_last(rcp_group_get_children(RCP_GROUP_PARAMETER(parameter)));
+    while (child != NULL)
+    {
+        if (recursive)
+        {
+            _add_resync_parameter(item, child->parameter, true);
+        }
+        else
+        {
+            _add_resync_id(item, rcp_parameter_get_id(child->parameter));
+        }
+
+        child = child->prev;
+    }
+}
 
-static inline void _rcp_server_send_to_one(rcp_server* server, const char* data, size_t size, void* client)
+// collect what the client has - all parameters, its subscribed groups and what it discovered
+static void _start_resync(rcp_server* server, client_list_item* item)
 {
-    transporter_list_item* le = server->transporters;
-    while (le)
+    item->resync = false;
+    item->resync_count = 0;
+    item->resync_next = 0;
+
+    if (item->initialized ||
+            _subscribed_all(item))
     {
-        le->transporter->sendToOne(le->transporter,
-                                   data,
-                                   size,
-                                   client);
+        rcp_parameter_list* pl = _list_last(rcp_manager_get_paramter_list(server->manager));
+        while (pl != NULL)
+        {
+            if (rcp_parameter_get_parent(pl->parameter) == NULL)
+            {
+                _add_resync_parameter(item, pl->parameter, true);
+            }
 
-        le = le->next;
+            pl = pl->prev;
+        }
+
+        return;
+    }
+
+    for (size_t i = 0; i < item->subscription_count; i++)
+    {
+        rcp_parameter* parameter = rcp_manager_get_parameter(server->manager, item->subscriptions[i]);
+        if (parameter != NULL &&
+                !_subscription_nested(server, item, parameter))
+        {
+            _add_resync_parameter(item, parameter, true);
+        }
+    }
+
+    for (size_t i = 0; i < item->discovered_count; i++)
+    {
+        rcp_parameter* parameter = rcp_manager_get_parameter(server->manager, item->discovered[i]);
+        if (parameter != NULL)
+        {
+            _add_resync_parameter(item, parameter, false);
+        }
+    }
+}
+
+// send the resync while the queue drains - one parameter at a time up to half the budget
+// the rest of the budget is left for updates
+static void _continue_resync(rcp_server* server, client_list_item* item)
+{
+    item->resyncing = true;
+
+    while (item->resync_next < item->resync_count &&
+           rcp_send_queue_get_size(item->queue) < server->client_queue_size / 2 + 1)
+    {
+        rcp_manager_send_state_list(server->manager, &item->resync_ids[item->resync_next++], 1, item->client);
+    }
+
+    item->resyncing = false;
+
+    if (item->resync_next >= item->resync_count)
+    {
+        item->resync_count = 0;
+        item->resync_next = 0;
+    }
+}
+
+static void _flush_clients(rcp_server* server)
+{
+    client_list_item* item = server->clients;
+    while (item != NULL)
+    {
+        _flush_client(server, item);
+
+        if (item->resync)
+        {
+            _start_resync(server, item);
+        }
+
+        if (item->resync_next < item->resync_count)
+        {
+            _continue_resync(server, item);
+        }
+
+        item = item->next;
     }
 }
 
 static inline void _rcp_server_send_to_all(rcp_server* server, const char* data, size_t size, void* client)
 {
+    if (server->subscribed_count > 0 ||
+            server->client_queue_size > 0)
+    {
+        bool except = _can_send_to_all_except(server);
+
+        if (except ||
+                server->client_queue_size > 0)
+        {
+            // clients with subscriptions only get their parameters
+            // clients with queues are sent one by one
+            if (except)
+            {
+                _send_to_all_except(server, data, size, client);
+            }
+
+            _send_to_subscribers(server, data, size, client);
+            return;
+        }
+
+        // transporters can not leave out subscribed clients - they get all data
+    }
+
+    // not scanned - the parameter tree may have changed
+    server->structure_version++;
+
     transporter_list_item* le = server->transporters;
     while (le)
     {
@@ -106,6 +1062,7 @@ rcp_server* rcp_server_create(rcp_server_transporter* transporter)
         RCP_SERVER_MALLOC_DEBUG("*** server: %p\n", server);
 
         server->manager = rcp_manager_create(server);
+        server->structure_version = 1;
 
         if (server->manager != NULL)
         {
@@ -118,6 +1075,10 @@ rcp_server* rcp_server_create(rcp_server_transporter* transporter)
         }
 
         rcp_server_add_transporter(server, transporter);
+
+#ifdef RCP_USE_ARENA
+        server->arena = rcp_arena_create(RCP_ARENA_BLOCK_SIZE);
+#endif
     }
     else
     {
@@ -140,13 +1101,57 @@ void rcp_server_free(rcp_server* server)
             next = le->next;
 
             RCP_SERVER_MALLOC_DEBUG("+++ transporter list item: %p\n", le);
-            RCP_FREE(le);
+            rcp_pool_release(server->transporter_pool, le);
 
             le = next;
         }
         server->transporters = NULL;
 
+        rcp_pool_free(server->transporter_pool);
+        server->transporter_pool = NULL;
+
+        // remove client list items
+        while (server->clients != NULL)
+        {
+            client_list_item* item = server->clients;
+            server->clients = item->next;
+
+            _free_client(server, item);
+        }
+
+        rcp_pool_free(server->client_pool);
+        server->client_pool = NULL;
+
+        if (server->client_buckets != NULL)
+        {
+            RCP_SERVER_MALLOC_DEBUG("+++ client buckets: %p\n", server->client_buckets);
+            RCP_FREE(server->client_buckets);
+        }
+
+        if (server->excluded != NULL)
+        {
+            RCP_SERVER_MALLOC_DEBUG("+++ excluded clients: %p\n", server->excluded);
+            RCP_FREE(server->excluded);
+        }
+
+        if (server->scan_infos != NULL)
+        {
+            RCP_SERVER_MALLOC_DEBUG("+++ scan infos: %p\n", server->scan_infos);
+            RCP_FREE(server->scan_infos);
+        }
+
+        if (server->filter_buffer != NULL)
+        {
+            RCP_SERVER_MALLOC_DEBUG("+++ filter buffer: %p\n", server->filter_buffer);
+            RCP_FREE(server->filter_buffer);
+        }
+
         rcp_manager_free(server->manager);
+        rcp_packet_free(server->receive_packet);
+
+#ifdef RCP_USE_ARENA
+        rcp_arena_free(server->arena);
+#endif
 
         if (server->applicationId)
         {
@@ -213,10 +1218,16 @@ void rcp_server_add_transporter(rcp_server* server, rcp_server_transporter* tran
         //--------------------------------
         // transporter does not yet exist
 
-        rcp_server_transporter_set_recv_cb(transporter, server, rcp_server_receive_cb);
+        rcp_server_transporter_set_recv_from_cb(transporter, server, _transporter_received);
+        rcp_server_transporter_set_disconnected_cb(transporter, server, _transporter_disconnected);
+
+        if (server->transporter_pool == NULL)
+        {
+            server->transporter_pool = rcp_pool_create(sizeof(transporter_list_item), 2);
+        }
 
         // add transporter to transporterlist
-        transporter_list_item* transporter_item = RCP_CALLOC(1, sizeof (transporter_list_item));
+        transporter_list_item* transporter_item = rcp_pool_alloc(server->transporter_pool);
         if (transporter_item)
         {
             RCP_SERVER_MALLOC_DEBUG("*** transporter list item: %p\n", transporter_item);
@@ -236,6 +1247,7 @@ void rcp_server_remove_transporter(rcp_server* server, rcp_server_transporter* t
         RCP_SERVER_DEBUG("remove transporter\n");
 
         rcp_server_transporter_set_recv_cb(transporter, NULL, NULL);
+        rcp_server_transporter_set_disconnected_cb(transporter, NULL, NULL);
 
         // remove transporter from serverlist
         transporter_list_item* item = server->transporters;
@@ -255,7 +1267,10 @@ void rcp_server_remove_transporter(rcp_server* server, rcp_server_transporter* t
 
                 // destroy list item
                 RCP_SERVER_MALLOC_DEBUG("+++ transporter list item: %p\n", item);
-                RCP_FREE(item);
+                rcp_pool_release(server->transporter_pool, item);
+
+                // its clients are gone
+                _remove_transporter_clients(server, transporter);
 
                 return;
             }
@@ -272,7 +1287,21 @@ void rcp_server_update(rcp_server* server)
     if (server && server->manager)
     {
         rcp_manager_update(server->manager);
+        _flush_clients(server);
+    }
+}
+
+// returns number of parameters still pending
+size_t rcp_server_update_budget(rcp_server* server, size_t max_bytes, uint64_t max_ns)
+{
+    if (server && server->manager)
+    {
+        size_t pending = rcp_manager_update_budget(server->manager, max_bytes, max_ns);
+        _flush_clients(server);
+        return pending;
     }
+
+    return 0;
 }
 
 void rcp_server_log(rcp_server* server)
@@ -329,13 +1358,17 @@ static inline void _do_command_info(rcp_server* server, rcp_packet* packet, void
     }
     else
     {
+        // a client requests info when it connects - forget the last session of this client
+        _reset_client(server, client);
+
         // no data, answer with own version
 
         rcp_packet* info_packet = rcp_packet_create(COMMAND_INFO);
 
         if (info_packet)
         {
-            rcp_infodata* info_data = rcp_infodata_create(RCP_VERSION, server->applicationId);
+            // announce protocol extensions
+            rcp_infodata* info_data = rcp_infodata_create(RCP_VERSION "+" RCP_VERSION_EXTENSIONS, server->applicationId);
 
             if (info_data)
             {
@@ -385,55 +1418,117 @@ static inline void _do_command_info(rcp_server* server, rcp_packet* packet, void
     }
 }
 
+// remember what a client requested for a resync
+// all: INITIALIZE without id
+static void _remember_request(rcp_server* server, void* client, int16_t id, bool all)
+{
+    if (server->client_queue_size == 0) return;
+
+    client_list_item* item = _get_client(server, client, false);
+    if (item == NULL) return;
+
+    if (all)
+    {
+        item->initialized = true;
+    }
+    else
+    {
+        _add_id(&item->discovered, &item->discovered_count, &item->discovered_size, id);
+    }
+}
+
 // send initial state of all parameters
+// the snapshot is shared by all clients and ends with INITIALIZE
+// it is sent in frames up to the init frame size of the manager
 static void send_initial_parameters(rcp_server* server, void* client)
 {
-    char* data_out = NULL;
-    size_t data_out_size = 0;
+    rcp_manager_send_snapshot(server->manager, client);
+}
+
+// receive from transporter
+static void _do_bang(rcp_server* server, int16_t id)
+{
+    rcp_parameter* cached_parameter = rcp_manager_get_parameter(server->manager, id);
 
-    rcp_packet* packet = rcp_packet_create(COMMAND_UPDATE);
-    if (packet == NULL)
+    if (cached_parameter)
     {
-        RCP_SERVER_DEBUG("could not create packet\n");
-        return;
+        if (rcp_parameter_is_type(cached_parameter, DATATYPE_BANG))
+        {
+            rcp_bang_parameter_call_bang_cb(RCP_BANG_PARAMETER(cached_parameter));
+        }
+        else
+        {
+            RCP_SERVER_DEBUG("server - bang parameter - type missmatch!\n");
+        }
     }
-
-    rcp_parameter_list* pe = rcp_manager_get_paramter_list(server->manager);
-    while (pe)
+    else
     {
-        rcp_packet_set_parameter(packet, pe->parameter);
+        RCP_ERROR("server - bang parameter - no cached parameter\n")
+    }
+}
 
-        data_out_size = rcp_packet_write(packet, &data_out, true);
+// handle packets which don't need to be parsed
+// returns false if the packet needs to be parsed
+static bool _do_scanned_packet(rcp_server* server, rcp_scan_info* info, const char* data, void* client)
+{
+    switch (info->command)
+    {
+    case COMMAND_REMOVE:
+        // no parameter removal on server
+        return true;
 
-        if (data_out_size > 0 &&
-                data_out != NULL)
+    case COMMAND_UPDATE:
+    case COMMAND_UPDATEVALUE:
+    {
+        if (info->type_id == DATATYPE_BANG
+                && (info->command == COMMAND_UPDATEVALUE
+                    || !info->has_options))
         {
-            // send it out...
-            _rcp_server_send_to_one(server, data_out, data_out_size, client);
+            _do_bang(server, info->id);
+            return true;
+        }
 
-            RCP_SERVER_MALLOC_DEBUG("+++ data out: %p\n", data_out);
-            RCP_FREE(data_out);
-            data_out = NULL;
+        rcp_parameter* cached_parameter = rcp_manager_get_parameter(server->manager, info->id);
+        if (cached_parameter == NULL
+                || !rcp_parameter_is_type(cached_parameter, info->type_id))
+        {
+            // nothing to update - relay this data to all other clients
+            _rcp_server_send_to_all(server, data, info->size, client);
+            return true;
         }
 
-        pe = pe->next;
+        // parse to update cached parameter
+        return false;
     }
 
-    // info: free packet without freeing parameter
-    rcp_packet_free(packet);
-
-    // send INITIALIZE after sending all parameter
-    char data[2] = {COMMAND_INITIALIZE, RCP_TERMINATOR};
-    _rcp_server_send_to_one(server, data, 2, client);
+    default:
+        return false;
+    }
 }
 
-// receive from transporter
 void rcp_server_receive_cb(rcp_server* server, const char* data, size_t size, void* client)
 {
     if (server == NULL) return;
 
+    // remember client if it gets a queue - data for all is sent to it one by one
+    // it is forgotten when it disconnects or its transporter is removed
+    client_list_item* item = _get_client(server, client, server->client_queue_size > 0);
+    if (item != NULL &&
+            item->transporter == NULL)
+    {
+        item->transporter = server->receive_transporter;
+    }
+
     // parse data
-    rcp_packet* packet = NULL;
+    // reuse receive packet - nested calls create their own
+    rcp_packet* packet = server->receive_packet;
+    server->receive_packet = NULL;
+
+#ifdef RCP_USE_ARENA
+    // parse into arena - nested calls parse without arena
+    rcp_arena* arena = server->arena;
+    server->arena = NULL;
+#endif
 
     // NOTE: don't use data and size directly
     // we need it to forward the data in case of COMMAND_UPDATE and COMMAND_UPDATEVALUE
@@ -443,6 +1538,36 @@ void rcp_server_receive_cb(rcp_server* server, const char* data, size_t size, vo
     while (parse_data != NULL
            && parse_data_size > 0)
     {
+        // fast path: apply value updates in place
+        const char* applied_data = rcp_manager_apply_value_update(server->manager, parse_data, &parse_data_size);
+        if (applied_data != NULL)
+        {
+            // relay this data to all other clients
+            _rcp_server_send_to_all(server, data, applied_data - data, client);
+
+            parse_data = applied_data;
+            data = parse_data;
+            continue;
+        }
+
+        // scan packet - skip parsing if the cache is not updated
+        rcp_scan_info info;
+        if (rcp_scanner_scan_packet(parse_data, parse_data_size, &info)
+                && _do_scanned_packet(server, &info, parse_data, client))
+        {
+            parse_data += info.size;
+            parse_data_size -= info.size;
+            data = parse_data;
+            continue;
+        }
+
+#ifdef RCP_USE_ARENA
+        rcp_arena* packet_arena = packet != NULL ? arena : NULL;
+        rcp_packet_set_arena(packet, packet_arena);
+#endif
+
+        // parameters are never added on the server - strings can reference data
+        rcp_packet_set_borrow_strings(packet, true);
         parse_data = rcp_packet_parse(parse_data, parse_data_size, &packet, &parse_data_size);
 
         if (parse_data && packet)
@@ -461,10 +1586,13 @@ void rcp_server_receive_cb(rcp_server* server, const char* data, size_t size, vo
 
                 // call pre_init cb?
 
+                _remember_request(server, client, id_data, id_data == 0);
+
                 if (id_data != 0)
                 {
-                    //
-                    RCP_SERVER_DEBUG("not implemented: init with id: %d\n", id_data);
+                    // send parameter - groups with their direct children
+                    RCP_SERVER_DEBUG("init with id: %d\n", id_data);
+                    rcp_manager_send_parameter(server->manager, id_data, false, client);
                 }
                 else
                 {
@@ -476,18 +1604,13 @@ void rcp_server_receive_cb(rcp_server* server, const char* data, size_t size, vo
 
             case COMMAND_DISCOVER:
             {
-                // TODO: implement
-                RCP_SERVER_DEBUG("not implemented - DISCOVER:\n");
+                // send parameters without values - id 0: root group
                 int16_t id_data = rcp_packet_get_iddata(packet);
+                RCP_SERVER_DEBUG("DISCOVER: %d\n", id_data);
 
-                if (id_data != 0)
-                {
-                    RCP_SERVER_DEBUG("discover with id: %d\n", id_data);
-                }
-                else
-                {
-                    // discover root group
-                }
+                _remember_request(server, client, id_data, false);
+
+                rcp_manager_send_parameter(server->manager, id_data, true, client);
                 break;
             }
 
@@ -506,23 +1629,7 @@ void rcp_server_receive_cb(rcp_server* server, const char* data, size_t size, vo
                                     )
                                 ))
                     {
-                        rcp_parameter* cached_parameter = rcp_manager_get_parameter(server->manager, rcp_parameter_get_id(parameter));
-
-                        if (cached_parameter)
-                        {
-                            if (rcp_parameter_is_type(cached_parameter, DATATYPE_BANG))
-                            {
-                                rcp_bang_parameter_call_bang_cb(RCP_BANG_PARAMETER(cached_parameter));
-                            }
-                            else
-                            {
-                                RCP_SERVER_DEBUG("server - bang parameter - type missmatch!\n");
-                            }
-                        }
-                        else
-                        {
-                            RCP_ERROR("server - bang parameter - no cached parameter\n")
-                        }
+                        _do_bang(server, rcp_parameter_get_id(parameter));
                     }
                     else
                     {
@@ -536,6 +1643,14 @@ void rcp_server_receive_cb(rcp_server* server, const char* data, size_t size, vo
                 break;
             }
 
+            case COMMAND_SUBSCRIBE:
+                rcp_server_subscribe(server, client, rcp_packet_get_iddata(packet));
+                break;
+
+            case COMMAND_UNSUBSCRIBE:
+                rcp_server_unsubscribe(server, client, rcp_packet_get_iddata(packet));
+                break;
+
             case COMMAND_REMOVE:
                 // no parameter removal on server
 
@@ -545,13 +1660,119 @@ void rcp_server_receive_cb(rcp_server* server, const char* data, size_t size, vo
                 break;
             }
 
-            //
+            data = parse_data;
+        }
+
+#ifdef RCP_USE_ARENA
+        if (packet_arena != NULL)
+        {
+            // release parsed parameter before its memory is reused
+            rcp_packet_reset(packet, COMMAND_INVALID);
+            rcp_packet_set_arena(packet, NULL);
+            rcp_arena_reset(packet_arena);
+        }
+#endif
+    }
+
+#ifdef RCP_USE_ARENA
+    server->arena = arena;
+#endif
+
+    if (packet != NULL)
+    {
+        if (server->receive_packet == NULL)
+        {
+            // keep it - release parsed data
+            rcp_packet_reset(packet, COMMAND_INVALID);
+            server->receive_packet = packet;
+        }
+        else
+        {
             rcp_packet_free(packet);
-            packet = NULL;
+        }
+    }
+}
 
-            data = parse_data;
+// transporter lost a client
+void rcp_server_client_disconnected_cb(rcp_server* server, void* client)
+{
+    if (server == NULL) return;
+
+    _remove_client(server, NULL, client);
+}
+
+// only send updates of parameter and its children to client
+// sends the current state of the group to the client
+// returns false if there is no such parameter
+bool rcp_server_subscribe(rcp_server* server, void* client, int16_t group_id)
+{
+    if (server == NULL) return false;
+
+    if (group_id != 0 &&
+            rcp_manager_get_parameter(server->manager, group_id) == NULL)
+    {
+        RCP_SERVER_DEBUG("subscribe: no parameter with id: %d\n", group_id);
+        return false;
+    }
+
+    client_list_item* item = _get_client(server, client, true);
+    if (item == NULL) return false;
+
+    size_t count = item->subscription_count;
+    if (!_add_id(&item->subscriptions, &item->subscription_count, &item->subscription_size, group_id))
+    {
+        return false;
+    }
+
+    if (count == 0)
+    {
+        server->subscribed_count++;
+    }
+
+    item->subscribed_version = 0;
+
+    RCP_SERVER_DEBUG("subscribe: %d\n", group_id);
+
+    // updates sent before the subscription may have been filtered
+    rcp_manager_send_state(server->manager, group_id, true, client);
+
+    return true;
+}
+
+// without subscriptions a client gets updates of all parameters again
+void rcp_server_unsubscribe(rcp_server* server, void* client, int16_t group_id)
+{
+    if (server == NULL) return;
+
+    client_list_item* item = _get_client(server, client, false);
+    if (item == NULL) return;
+    if (item->subscription_count == 0) return;
+
+    if (group_id == 0)
+    {
+        item->subscription_count = 0;
+    }
+    else
+    {
+        for (size_t i = 0; i < item->subscription_count; i++)
+        {
+            if (item->subscriptions[i] == group_id)
+            {
+                item->subscriptions[i] = item->subscriptions[--item->subscription_count];
+                break;
+            }
         }
     }
+
+    RCP_SERVER_DEBUG("unsubscribe: %d\n", group_id);
+
+    item->subscribed_version = 0;
+
+    if (item->subscription_count == 0)
+    {
+        server->subscribed_count--;
+        _release_client(server, item);
+    }
 }
 
 rcp_value_parameter* rcp_server_expose_bool(rcp_server* server, const char* label, rcp_group_parameter* group)
@@ -791,3 +2012,49 @@ rcp_group_parameter* rcp_server_find_group(rcp_server* server, const char* name,
 	
 	return rcp_manager_find_group(server->manager, name, group);
 }
+
+void rcp_server_set_client_queue_size(rcp_server* server, size_t max_bytes)
+{
+    if (server == NULL) return;
+
+    server->client_queue_size = max_bytes;
+
+    if (max_bytes == 0)
+    {
+        // send what the transporters accept - drop the rest
+        client_list_item* item = server->clients;
+        while (item != NULL)
+        {
+            client_list_item* next = item->next;
+
+            _flush_client(server, item);
+
+            if (rcp_send_queue_get_size(item->queue) > 0)
+            {
+                RCP_ERROR("dropping %d queued bytes\n", rcp_send_queue_get_size(item->queue));
+            }
+
+            rcp_send_queue_free(item->queue);
+            item->queue = NULL;
+            item->resync = false;
+            item->resync_count = 0;
+            item->resync_next = 0;
+            item->initialized = false;
+            item->discovered_count = 0;
+
+            _release_client(server, item);
+
+            item = next;
+        }
+    }
+}
+
+size_t rcp_server_get_client_queue_pending(rcp_server* server, void* client)
+{
+    if (server == NULL) return 0;
+
+    client_list_item* item = _get_client(server, client, false);
+    if (item == NULL) return 0;
+
+    return rcp_send_queue_get_size(item->queue);
+}
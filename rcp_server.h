@@ -55,6 +55,7 @@ void rcp_server_remove_transporter(rcp_server* server, rcp_server_transporter* t
 
 // update server (removes parameters, sends dirty parmeter)
 void rcp_server_update(rcp_server* server);
+size_t rcp_server_update_budget(rcp_server* server, size_t max_bytes, uint64_t max_ns);
 
 // expose parameter
 rcp_value_parameter* rcp_server_expose_bool(rcp_server* server, const char* label, rcp_group_parameter* group);
@@ -82,6 +83,25 @@ void rcp_server_manager_data_cb_all(void* server, const char* data, size_t size)
 
 // called from transporter
 void rcp_server_receive_cb(rcp_server* server, const char* data, size_t size, void* client);
+void rcp_server_client_disconnected_cb(rcp_server* server, void* client);
+
+// subscriptions of a client - empty: all parameters
+// subscribing sends the current state of the group to the client
+// values are filtered if all transporters have sendToAllExcept
+// structure changes reach all clients: parameters with metadata (label, parent, ...) and removals
+// a new parameter without any metadata only reaches clients with its values
+// subscriptions end when the client disconnects or sends INFO on a new connection
+bool rcp_server_subscribe(rcp_server* server, void* client, int16_t group_id); // 0: root group
+void rcp_server_unsubscribe(rcp_server* server, void* client, int16_t group_id); // 0: all groups
+
+// outbound queue per client - 0: send directly (default)
+// data a transporter does not accept (trySendToOne) is queued and sent on update
+// a full queue coalesces values of the same parameter, then drops pending values
+// and resends the state of what the client has while the queue drains
+// a queue stays within max_bytes plus one frame
+// every client which sends data gets a queue - transporters need to report disconnects
+void rcp_server_set_client_queue_size(rcp_server* server, size_t max_bytes);
+size_t rcp_server_get_client_queue_pending(rcp_server* server, void* client); // bytes
 
 
 // logging
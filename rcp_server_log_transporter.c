@@ -50,6 +50,9 @@ rcp_server_log_transporter* rcp_server_log_transporter_create()
         rcp_server_transporter_setup(RCP_TRANSPORTER(t),
                                      rcp_server_log_transporter_send_to_one,
                                      rcp_server_log_transporter_send_to_all);
+
+        rcp_server_transporter_set_send_to_all_except(RCP_SERVER_TRANSPORTER(t),
+                                                      rcp_server_log_transporter_send_to_all_except);
     }
 
     return t;
@@ -71,13 +74,10 @@ void rcp_server_log_transporter_push_data(rcp_server_log_transporter* transporte
             data  &&
             size > 0)
     {
-        if (transporter->transporter.received)
-        {
-            transporter->transporter.received(transporter->transporter.server,
-                                              data,
-                                              size,
-                                              NULL);
-        }
+        rcp_server_transporter_call_recv_cb(RCP_SERVER_TRANSPORTER(transporter),
+                                            data,
+                                            size,
+                                            NULL);
     }
 }
 
@@ -91,6 +91,9 @@ void rcp_server_log_transporter_unbind(rcp_server_transporter* transporter)
 {
     rcp_server_log_transporter* t = (rcp_server_log_transporter*)transporter;
     RCP_INFO("close some connection!");
+
+    // the only client is gone
+    rcp_server_transporter_call_disconnected_cb(transporter, NULL);
 }
 
 void rcp_server_log_transporter_send_to_one(rcp_server_transporter* transporter, const char* data, size_t size, void* id)
@@ -117,6 +120,20 @@ void rcp_server_log_transporter_send_to_all(rcp_server_transporter* transporter,
     RCP_INFO_ONLY("\n");
 }
 
+void rcp_server_log_transporter_send_to_all_except(rcp_server_transporter* transporter, const char* data, size_t size, void** excludeIds, size_t count)
+{
+    // the only client is NULL
+    for (size_t i=0; i<count; i++)
+    {
+        if (excludeIds[i] == NULL)
+        {
+            return;
+        }
+    }
+
+    rcp_server_log_transporter_send_to_all(transporter, data, size, NULL);
+}
+
 int rcp_server_log_transporter_connection_count(rcp_server_transporter* transporter)
 {
     return 1;
@@ -53,6 +53,7 @@ void rcp_server_log_transporter_unbind(rcp_server_transporter* transporter);
 
 void rcp_server_log_transporter_send_to_one(rcp_server_transporter* transporter, const char* data, size_t size, void* id);
 void rcp_server_log_transporter_send_to_all(rcp_server_transporter* transporter, const char* data, size_t size, void* excludeId);
+void rcp_server_log_transporter_send_to_all_except(rcp_server_transporter* transporter, const char* data, size_t size, void** excludeIds, size_t count);
 int rcp_server_log_transporter_connection_count(rcp_server_transporter* transporter);
 
 
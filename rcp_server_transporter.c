@@ -42,22 +42,78 @@ rcp_server_transporter* rcp_server_transporter_setup(rcp_server_transporter* t,
     return t;
 }
 
+void rcp_server_transporter_set_try_send(rcp_server_transporter* t,
+                                         size_t (*trySendToOne)(rcp_server_transporter* transporter, const char* data, size_t size, void* id))
+{
+    if (t)
+    {
+        t->trySendToOne = trySendToOne;
+    }
+}
+
+void rcp_server_transporter_set_send_to_all_except(rcp_server_transporter* t,
+                                                   void (*sendToAllExcept)(rcp_server_transporter* transporter, const char* data, size_t size, void** excludeIds, size_t count))
+{
+    if (t)
+    {
+        t->sendToAllExcept = sendToAllExcept;
+    }
+}
+
 
 void rcp_server_transporter_set_recv_cb(rcp_server_transporter* t,
                                         rcp_server* server,
-                                        void (*received)(rcp_server* server, const char* data, size_t size, void* user))
+                                        void (*received)(rcp_server* server, const char* data, size_t size, void* client))
 {
     if (t)
     {
         t->received = received;
+        t->receivedFrom = NULL;
+        t->server = server;
+    }
+}
+
+void rcp_server_transporter_set_recv_from_cb(rcp_server_transporter* t,
+                                             rcp_server* server,
+                                             void (*receivedFrom)(rcp_server_transporter* transporter, const char* data, size_t size, void* client))
+{
+    if (t)
+    {
+        t->receivedFrom = receivedFrom;
+        t->received = NULL;
         t->server = server;
     }
 }
 
 void rcp_server_transporter_call_recv_cb(rcp_server_transporter* t, const char* data, size_t size, void* client)
 {
-    if (t && t->received)
+    if (t == NULL) return;
+
+    if (t->receivedFrom)
+    {
+        t->receivedFrom(t, data, size, client);
+    }
+    else if (t->received)
     {
         t->received(t->server, data, size, client);
     }
 }
+
+void rcp_server_transporter_set_disconnected_cb(rcp_server_transporter* t,
+                                                rcp_server* server,
+                                                void (*disconnected)(rcp_server_transporter* transporter, void* client))
+{
+    if (t)
+    {
+        t->disconnected = disconnected;
+        t->server = server;
+    }
+}
+
+void rcp_server_transporter_call_disconnected_cb(rcp_server_transporter* t, void* client)
+{
+    if (t && t->disconnected)
+    {
+        t->disconnected(t, client);
+    }
+}
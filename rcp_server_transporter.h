@@ -41,9 +41,21 @@ struct rcp_server_transporter
     void (*sendToOne)(rcp_server_transporter* transporter, const char* data, size_t size, void* id);
     void (*sendToAll)(rcp_server_transporter* transporter, const char* data, size_t size, void* excludeId);
 
+    // optional - returns number of bytes accepted, used by client queues (rcp_server_set_client_queue_size)
+    size_t (*trySendToOne)(rcp_server_transporter* transporter, const char* data, size_t size, void* id);
+
+    // optional - send to all clients except count clients of excludeIds, used by subscriptions
+    void (*sendToAllExcept)(rcp_server_transporter* transporter, const char* data, size_t size, void** excludeIds, size_t count);
+
     // received callback
     void (*received)(rcp_server* server, const char* data, size_t size, void* client);
 
+    // received callback with the transporter - used instead of received if set
+    void (*receivedFrom)(rcp_server_transporter* transporter, const char* data, size_t size, void* client);
+
+    // client disconnected callback
+    void (*disconnected)(rcp_server_transporter* transporter, void* client);
+
     // server reference
     rcp_server* server;
     void* user;
@@ -56,14 +68,42 @@ rcp_server_transporter* rcp_server_transporter_setup(rcp_server_transporter* t,
                                                      void (*sendToOne)(rcp_server_transporter* transporter, const char* data, size_t size, void* id),
                                                      void (*sendTAll)(rcp_server_transporter* transporter, const char* data, size_t size, void* excludeId));
 
+// send with backpressure (optional)
+// accept all data or less if the link is busy - the rest is sent again on rcp_server_update
+// message based transporters accept all or nothing
+// return size for clients of other transporters
+void rcp_server_transporter_set_try_send(rcp_server_transporter* t,
+                                         size_t (*trySendToOne)(rcp_server_transporter* transporter, const char* data, size_t size, void* id));
+
+// send to all but some clients (optional)
+// the server sends to subscribed clients one by one and to all others with this
+// without it on all transporters subscribed clients get updates of all parameters
+void rcp_server_transporter_set_send_to_all_except(rcp_server_transporter* t,
+                                                   void (*sendToAllExcept)(rcp_server_transporter* transporter, const char* data, size_t size, void** excludeIds, size_t count));
+
 // callback (set by rcp_server)
 void rcp_server_transporter_set_recv_cb(rcp_server_transporter* t,
                                         rcp_server* server,
                                         void (*received)(rcp_server* server, const char* data, size_t size, void* client));
 
+// callback which gets the transporter (set by rcp_server) - replaces received
+void rcp_server_transporter_set_recv_from_cb(rcp_server_transporter* t,
+                                             rcp_server* server,
+                                             void (*receivedFrom)(rcp_server_transporter* transporter, const char* data, size_t size, void* client));
+
 // call callback (call when new data arrived)
 void rcp_server_transporter_call_recv_cb(rcp_server_transporter* t, const char* data, size_t size, void* client);
 
+// callback (set by rcp_server)
+void rcp_server_transporter_set_disconnected_cb(rcp_server_transporter* t,
+                                                rcp_server* server,
+                                                void (*disconnected)(rcp_server_transporter* transporter, void* client));
+
+// call callback (call when a client disconnected)
+// needed for subscriptions and client queues - the server keeps state of such a client
+// until it disconnects, sends INFO on a new connection or the transporter is removed
+void rcp_server_transporter_call_disconnected_cb(rcp_server_transporter* t, void* client);
+
 
 #ifdef __cplusplus
 } // extern "C"
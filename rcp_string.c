@@ -44,265 +44,263 @@
 #define RCP_STRING_MALLOC_DEBUG(...)
 #endif
 
-// read tiny string from data and store it into option
-const char* rcp_read_tiny_string_option(rcp_option** options, const char* data, size_t* size, char option_prefix)
+// copy string view into zero-terminated string
+static char* _copy_view(const char* str, size_t str_len)
 {
-    if (options == NULL) return NULL;
-
-    uint8_t str_len = 0;
-    char* string_data = NULL;
-
-    // copy string from data into string_data
-    data = rcp_read_tiny_string(data, size, &string_data, &str_len);
-
-    if (data &&
-            str_len > 0 &&
-            string_data != NULL)
+    char* target = (char*)RCP_CALLOC(1, str_len + 1);
+    if (target != NULL)
     {
-        RCP_STRING_DEBUG("tiny string: %s\n", string_data);
-
-        rcp_option* opt = rcp_option_get_create(options, option_prefix);
-        rcp_option_free_data(opt);
+        RCP_STRING_MALLOC_DEBUG("*** string [%d]: %p\n", str_len, (void*)target);
 
-        // full transfer
-        rcp_option_move_string(opt, string_data, TINY_STRING);
+        memcpy(target, str, str_len);
     }
     else
     {
-        RCP_STRING_DEBUG("error reading tiny string: %s\n", string_data);
+        RCP_ERROR("could not malloc for string\n");
     }
 
-    return data;
+    return target;
 }
 
-// read short string from data and store it into option
-const char* rcp_read_short_string_option(rcp_option** options, const char* data, size_t* size, char option_prefix)
+// borrow or copy string into option
+static bool _option_put_string(rcp_option* opt, const char* str, size_t str_len, rcp_string_types type, bool borrow)
+{
+    if (borrow)
+    {
+        return rcp_option_borrow_string(opt, str, str_len, type);
+    }
+
+    char* string_data = _copy_view(str, str_len);
+    if (string_data == NULL) return false;
+
+    // full transfer
+    rcp_option_move_string(opt, string_data, type);
+    return true;
+}
+
+// read string of type from data into option
+static const char* _read_string_option(rcp_option** options, const char* data, size_t* size, char option_prefix, rcp_string_types type)
 {
     if (options == NULL) return NULL;
 
-    uint16_t str_len;
-    char* string_data = NULL;
+    const char* str = NULL;
+    uint32_t str_len = 0;
 
-    data = rcp_read_short_string(data, size, &string_data, &str_len);
+    data = rcp_read_string_view(data, size, type, &str, &str_len);
 
     if (data &&
-            str_len > 0 &&
-            string_data != NULL)
+            str_len > 0)
     {
-        RCP_STRING_DEBUG("short string: %s\n", string_data);
+        RCP_STRING_DEBUG("string: %.*s\n", (int)str_len, str);
 
         rcp_option* opt = rcp_option_get_create(options, option_prefix);
         rcp_option_free_data(opt);
 
-        // full transfer
-        rcp_option_move_string(opt, string_data, SHORT_STRING);
+        _option_put_string(opt, str, str_len, type, false);
     }
     else
     {
-        RCP_STRING_DEBUG("error reading short string: %s\n", string_data);
+        RCP_STRING_DEBUG("error reading string\n");
     }
 
     return data;
 }
 
-// copy tiny-string from data into target
-const char* rcp_read_tiny_string(const char* data, size_t* size, char** target, uint8_t* str_length)
+// read tiny string from data and store it into option
+const char* rcp_read_tiny_string_option(rcp_option** options, const char* data, size_t* size, char option_prefix)
 {
-    if (data == NULL) return NULL;
-    if (target == NULL) return NULL;
-    if (*size < 1) return NULL;
+    return _read_string_option(options, data, size, option_prefix, TINY_STRING);
+}
 
-    // read string length
-    data = rcp_read_u8(data, size, str_length);
+// read short string from data and store it into option
+const char* rcp_read_short_string_option(rcp_option** options, const char* data, size_t* size, char option_prefix)
+{
+    return _read_string_option(options, data, size, option_prefix, SHORT_STRING);
+}
+
+// read string of type from data into opt
+// with borrow set opt references data instead of owning a copy
+const char* rcp_read_string_into_option(rcp_option* opt, const char* data, size_t* size, rcp_string_types type, bool borrow)
+{
+    if (opt == NULL) return NULL;
+
+    const char* str = NULL;
+    uint32_t str_len = 0;
+
+    data = rcp_read_string_view(data, size, type, &str, &str_len);
     if (data == NULL) return NULL;
 
-    // check if we have more data
-    if (*size == 0) return NULL;
+    rcp_option_free_data(opt);
 
-    if (*str_length > 0)
-    {
-        *target = (char*)RCP_CALLOC(1, *str_length + 1);
-        if (*target != NULL)
-        {
-            RCP_STRING_MALLOC_DEBUG("*** tiny string: %p\n", (void*)*target);
-
-            // copy data
-            strncpy(*target, data, *str_length);
-
-            // decrease size
-            *size -= *str_length;
-            // return new location in data
-            return data + *str_length;
-        }
-        else
-        {
-            RCP_ERROR("could not malloc for tiny string\n");
-        }
-    }
-    else
+    if (str_len > 0)
     {
-        *target = NULL;
+        _option_put_string(opt, str, str_len, type, borrow);
     }
 
-    // 0 length string - just return data
     return data;
 }
 
-const char* rcp_read_short_string(const char* data, size_t* size, char** target, uint16_t* str_length)
+// point target into data - no allocation, target is not zero-terminated
+const char* rcp_read_string_view(const char* data, size_t* size, rcp_string_types type, const char** target, uint32_t* str_length)
 {
     if (data == NULL) return NULL;
+    if (size == NULL) return NULL;
     if (target == NULL) return NULL;
-    if (*size < 2) return NULL;
+    if (str_length == NULL) return NULL;
+    if (*size < (size_t)type) return NULL;
 
     // read string length
-    data = rcp_read_i16(data, size, (int16_t*)str_length);
-    if (data == NULL) return NULL;
-
-    // check if we have more data
-    if (*size == 0) return NULL;
-
-    if (*str_length > 0)
+    switch (type)
     {
-        *target = RCP_CALLOC(1, *str_length + 1);
-        if (*target != NULL)
-        {
-            RCP_STRING_MALLOC_DEBUG("*** short string: %p\n", (void*)*target);
-
-            // copy data
-            strncpy(*target, data, *str_length);
-
-            // decrease size
-            *size -= *str_length;
-            // return new location in data
-            return data + *str_length;
-        }
-        else
-        {
-            RCP_ERROR("could not malloc for short string\n");
-        }
+    case TINY_STRING:
+    {
+        uint8_t len = 0;
+        data = rcp_read_u8(data, size, &len);
+        *str_length = len;
+        break;
     }
-    else
+    case SHORT_STRING:
     {
-        *target = NULL;
+        int16_t len = 0;
+        data = rcp_read_i16(data, size, &len);
+        *str_length = (uint16_t)len;
+        break;
+    }
+    case LONG_STRING:
+    {
+        int32_t len = 0;
+        data = rcp_read_i32(data, size, &len);
+        *str_length = (uint32_t)len;
+        break;
+    }
+    default:
+        return NULL;
     }
 
-    // 0 length string - just return data
-    return data;
+    if (data == NULL) return NULL;
+
+    if (*size < *str_length)
+    {
+        RCP_STRING_DEBUG("string exceeds data: %lu > %lu\n", (unsigned long)*str_length, (unsigned long)*size);
+        return NULL;
+    }
+
+    *target = *str_length > 0 ? data : NULL;
+    *size -= *str_length;
+    return data + *str_length;
 }
 
-const char* rcp_read_long_string(const char* data, size_t* size, char** target, uint32_t* str_length)
+// copy string from data into target
+static const char* _read_string(const char* data, size_t* size, rcp_string_types type, char** target, uint32_t* str_length)
 {
-    if (data == NULL) return NULL;
     if (target == NULL) return NULL;
-    if (*size < 4) return NULL;
 
-    // read string length
-    data = rcp_read_i32(data, size, (int32_t*)str_length);
+    const char* str = NULL;
+    data = rcp_read_string_view(data, size, type, &str, str_length);
     if (data == NULL) return NULL;
 
-    // check if we have more data
-    if (*size == 0) return NULL;
+    *target = NULL;
 
     if (*str_length > 0)
     {
-        // zero terminated string
-        *target = (char*)RCP_CALLOC(1, *str_length + 1);
-        if (*target != NULL)
-        {
-            RCP_STRING_MALLOC_DEBUG("*** long string [%d]: %p\n", *str_length, (void*)*target);
-
-            // copy data
-            strncpy(*target, data, *str_length);
-
-            // decrease size
-            *size -= *str_length;
-            // return new location in data
-            return data + *str_length;
-        }
-        else
-        {
-            RCP_ERROR("could not malloc for long string\n");
-        }
-    }
-    else
-    {
-        *target = NULL;
+        *target = _copy_view(str, *str_length);
+        if (*target == NULL) return NULL;
     }
 
-    // 0 length string - just return data
     return data;
 }
 
+// copy tiny-string from data into target
+const char* rcp_read_tiny_string(const char* data, size_t* size, char** target, uint8_t* str_length)
+{
+    uint32_t len = 0;
+    data = _read_string(data, size, TINY_STRING, target, &len);
+    *str_length = (uint8_t)len;
+    return data;
+}
+
+const char* rcp_read_short_string(const char* data, size_t* size, char** target, uint16_t* str_length)
+{
+    uint32_t len = 0;
+    data = _read_string(data, size, SHORT_STRING, target, &len);
+    *str_length = (uint16_t)len;
+    return data;
+}
 
-size_t rcp_write_tiny_string(char* dst, size_t size, const char* str)
+const char* rcp_read_long_string(const char* data, size_t* size, char** target, uint32_t* str_length)
 {
-    if (dst == NULL) return 0;
-    if (size == 0) return 0;
+    return _read_string(data, size, LONG_STRING, target, str_length);
+}
 
-    RCP_STRING_DEBUG("rcp_write_tiny_string: %s\n", (str != NULL ? str : "null"));
 
-    size_t str_len = str != NULL ? strlen(str) : 0;
+// write str_len characters of str with length prefix of type
+size_t rcp_write_string(char* dst, size_t size, const char* str, size_t str_len, rcp_string_types type)
+{
+    if (dst == NULL) return 0;
+    if (size == 0) return 0;
+    if (str == NULL) str_len = 0;
 
-    if (str_len > RCP_TINY_STRING_MAX_SIZE)
+    if (size < (str_len + type))
     {
-        str_len = RCP_TINY_STRING_MAX_SIZE;
+        RCP_STRING_DEBUG("write string: insufficient memory\n");
+        return 0;
     }
 
-    if (size < (str_len+TINY_STRING))
+    // write size
+    switch (type)
     {
-        RCP_ERROR("write tiny string: insufficient memory\n")
+    case TINY_STRING:
+        dst[0] = (char)str_len;
+        break;
+    case SHORT_STRING:
+        _rcp_store16(dst, (uint16_t)str_len);
+        break;
+    case LONG_STRING:
+        _rcp_store32(dst, (uint32_t)str_len);
+        break;
+    default:
         return 0;
     }
 
-    // write size
-    dst[0] = (char)str_len;
-
     if (str_len > 0)
     {
-        memcpy(dst+TINY_STRING, str, str_len);
+        memcpy(dst + type, str, str_len);
     }
 
     // return offset
-    return str_len + TINY_STRING;
+    return str_len + type;
 }
 
-size_t rcp_write_short_string(char* dst, size_t size, const char* str)
+size_t rcp_write_tiny_string(char* dst, size_t size, const char* str)
 {
-    if (dst == NULL) return 0;
-    if (size == 0) return 0;
-
-    RCP_STRING_DEBUG("rcp_write_short_string: %s\n", (str != NULL ? str : "null"));
+    RCP_STRING_DEBUG("rcp_write_tiny_string: %s\n", (str != NULL ? str : "null"));
 
     size_t str_len = str != NULL ? strlen(str) : 0;
 
-    if (str_len > RCP_SHORT_STRING_MAX_SIZE)
+    if (str_len > RCP_TINY_STRING_MAX_SIZE)
     {
-        str_len = RCP_SHORT_STRING_MAX_SIZE;
+        str_len = RCP_TINY_STRING_MAX_SIZE;
     }
 
-    if (size < (str_len+SHORT_STRING))
-    {
-        RCP_ERROR("write short string: insufficient memory\n")
-        return 0;
-    }
+    return rcp_write_string(dst, size, str, str_len, TINY_STRING);
+}
 
-    // write size
-    _rcp_store16(dst, (uint16_t)str_len);
+size_t rcp_write_short_string(char* dst, size_t size, const char* str)
+{
+    RCP_STRING_DEBUG("rcp_write_short_string: %s\n", (str != NULL ? str : "null"));
 
-    if (str_len > 0)
+    size_t str_len = str != NULL ? strlen(str) : 0;
+
+    if (str_len > RCP_SHORT_STRING_MAX_SIZE)
     {
-        memcpy(dst+SHORT_STRING, str, str_len);
+        str_len = RCP_SHORT_STRING_MAX_SIZE;
     }
 
-    // return offset
-    return str_len + SHORT_STRING;
+    return rcp_write_string(dst, size, str, str_len, SHORT_STRING);
 }
 
 size_t rcp_write_long_string(char* dst, size_t size, const char* str)
 {
-    if (dst == NULL) return 0;
-    if (size == 0) return 0;
-
     RCP_STRING_DEBUG("rcp_write_long_string: %s\n", (str != NULL ? str : "null"));
 
     size_t str_len = str != NULL ? strlen(str) : 0;
@@ -312,20 +310,5 @@ size_t rcp_write_long_string(char* dst, size_t size, const char* str)
         str_len = RCP_LONG_STRING_MAX_SIZE;
     }
 
-    if (size < (str_len+LONG_STRING))
-    {
-        RCP_ERROR("write long string: insufficient memory\n")
-        return 0;
-    }
-
-    // write size
-    _rcp_store32(dst, (uint32_t)str_len);
-
-    if (str_len > 0)
-    {
-        memcpy(dst+LONG_STRING, str, str_len);
-    }
-
-    // return offset
-    return str_len + LONG_STRING;
+    return rcp_write_string(dst, size, str, str_len, LONG_STRING);
 }
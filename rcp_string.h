@@ -39,14 +39,19 @@ extern "C"{
 //#define RCP_STRING_MALLOC_DEBUG_LOG
 
 
+// string view into data - no allocation, target is not zero-terminated
+const char* rcp_read_string_view(const char* data, size_t* size, rcp_string_types type, const char** target, uint32_t* str_length);
+
 const char* rcp_read_tiny_string(const char* data, size_t* size, char** target, uint8_t* str_length);
 const char* rcp_read_short_string(const char* data, size_t* size, char** target, uint16_t* str_length);
 const char* rcp_read_long_string(const char* data, size_t* size, char** target, uint32_t* str_length);
 
 const char* rcp_read_tiny_string_option(rcp_option** options, const char* data, size_t* size, char option_prefix);
 const char* rcp_read_short_string_option(rcp_option** options, const char* data, size_t* size, char option_prefix);
+const char* rcp_read_string_into_option(rcp_option* opt, const char* data, size_t* size, rcp_string_types type, bool borrow); // borrow: reference data
 
 
+size_t rcp_write_string(char* dst, size_t size, const char* str, size_t str_len, rcp_string_types type);
 size_t rcp_write_tiny_string(char* dst, size_t size, const char* str);
 size_t rcp_write_short_string(char* dst, size_t size, const char* str);
 size_t rcp_write_long_string(char* dst, size_t size, const char* str);
@@ -52,6 +52,9 @@ struct rcp_typedefinition
 
     // options
     rcp_option* options;
+
+    // memory of typedefinition and its option nodes - NULL: heap
+    rcp_arena* arena;
 };
 
 
@@ -73,17 +76,33 @@ struct rcp_typedefinition_custom
 
 
 
+static void* _alloc(rcp_arena* arena, size_t size)
+{
+    if (arena != NULL)
+    {
+        return rcp_arena_calloc(arena, 1, size);
+    }
+
+    return RCP_CALLOC(1, size);
+}
+
 rcp_typedefinition* rcp_typedefinition_create(rcp_datatype type_id)
+{
+    return rcp_typedefinition_create_in(type_id, NULL);
+}
+
+rcp_typedefinition* rcp_typedefinition_create_in(rcp_datatype type_id, rcp_arena* arena)
 {
     if (type_id == DATATYPE_CUSTOMTYPE)
     {
-        rcp_typedefinition_custom* td = RCP_CALLOC(1, sizeof(rcp_typedefinition_custom));
+        rcp_typedefinition_custom* td = _alloc(arena, sizeof(rcp_typedefinition_custom));
 
         if (td != NULL)
         {
             RCP_TYPEDEFINITION_MALLOC_DEBUG("*** type definition custom: %p\n", td);
 
             td->default_typedefinition.type_id = DATATYPE_CUSTOMTYPE;
+            td->default_typedefinition.arena = arena;
 
             return &td->default_typedefinition;
         }
@@ -91,13 +110,14 @@ rcp_typedefinition* rcp_typedefinition_create(rcp_datatype type_id)
         return NULL;
     }
 
-    rcp_typedefinition* td = (rcp_typedefinition*)RCP_CALLOC(1, sizeof(rcp_typedefinition));
+    rcp_typedefinition* td = (rcp_typedefinition*)_alloc(arena, sizeof(rcp_typedefinition));
 
     if (td != NULL)
     {
         RCP_TYPEDEFINITION_MALLOC_DEBUG("*** type definition: %p\n", td);
 
         td->type_id = type_id;
+        td->arena = arena;
     }
 
     return td;
@@ -109,12 +129,21 @@ void rcp_typedefinition_free(rcp_typedefinition* typedefinition)
     {
         rcp_option_free_chain(typedefinition->options);
 
-        RCP_TYPEDEFINITION_MALLOC_DEBUG("+++ typedefinition: %p\n", typedefinition);
-        RCP_FREE(typedefinition);
+        if (typedefinition->arena == NULL)
+        {
+            RCP_TYPEDEFINITION_MALLOC_DEBUG("+++ typedefinition: %p\n", typedefinition);
+            RCP_FREE(typedefinition);
+        }
     }
 
 }
 
+// option nodes of parsed typedefinitions live in their arena
+static rcp_option* _get_create_option(rcp_typedefinition* typedefinition, char prefix)
+{
+    return rcp_option_get_create_in(&typedefinition->options, prefix, typedefinition->arena);
+}
+
 rcp_datatype rcp_typedefinition_get_type_id(rcp_typedefinition* typedefinition)
 {
     if (typedefinition == NULL) return 0;
@@ -137,35 +166,35 @@ bool rcp_typedefinition_has_option(rcp_typedefinition* typedefinition, char pref
 bool rcp_typedefinition_set_option_bool(rcp_typedefinition* typedefinition, char prefix, bool value)
 {
     if (typedefinition == NULL) return false;
-    rcp_option* opt = rcp_option_get_create(&typedefinition->options, prefix);
+    rcp_option* opt = _get_create_option(typedefinition, prefix);
 	return rcp_option_set_bool(opt, value);
 }
 
 bool rcp_typedefinition_set_option_i8(rcp_typedefinition* typedefinition, char prefix, int8_t value)
 {
     if (typedefinition == NULL) return false;
-    rcp_option* opt = rcp_option_get_create(&typedefinition->options, prefix);
+    rcp_option* opt = _get_create_option(typedefinition, prefix);
 	return rcp_option_set_i8(opt, value);
 }
 
 bool rcp_typedefinition_set_option_i16(rcp_typedefinition* typedefinition, char prefix, int16_t value)
 {
     if (typedefinition == NULL) return false;
-    rcp_option* opt = rcp_option_get_create(&typedefinition->options, prefix);
+    rcp_option* opt = _get_create_option(typedefinition, prefix);
 	return rcp_option_set_i16(opt, value);
 }
 
 bool rcp_typedefinition_set_option_i32(rcp_typedefinition* typedefinition, char prefix, int32_t value)
 {
     if (typedefinition == NULL) return false;
-    rcp_option* opt = rcp_option_get_create(&typedefinition->options, prefix);
+    rcp_option* opt = _get_create_option(typedefinition, prefix);
 	return rcp_option_set_i32(opt, value);
 }
 
 bool rcp_typedefinition_set_option_f32(rcp_typedefinition* typedefinition, char prefix, float value)
 {
     if (typedefinition == NULL) return false;
-    rcp_option* opt = rcp_option_get_create(&typedefinition->options, prefix);
+    rcp_option* opt = _get_create_option(typedefinition, prefix);
 	return rcp_option_set_f32(opt, value);
 }
 
@@ -173,7 +202,7 @@ bool rcp_typedefinition_set_option_f32(rcp_typedefinition* typedefinition, char
 bool rcp_typedefinition_set_option_v2f32(rcp_typedefinition* typedefinition, char prefix, float x, float y)
 {
     if (typedefinition == NULL) return false;
-    rcp_option* opt = rcp_option_get_create(&typedefinition->options, prefix);
+    rcp_option* opt = _get_create_option(typedefinition, prefix);
     return rcp_option_set_vector2f(opt, x, y);
 }
 
@@ -181,7 +210,7 @@ bool rcp_typedefinition_set_option_v2f32(rcp_typedefinition* typedefinition, cha
 bool rcp_typedefinition_set_option_string_tiny(rcp_typedefinition* typedefinition, char prefix, const char* value)
 {
     if (typedefinition == NULL) return false;
-    rcp_option* opt = rcp_option_get_create(&typedefinition->options, prefix);
+    rcp_option* opt = _get_create_option(typedefinition, prefix);
 	return rcp_option_copy_string(opt, value, TINY_STRING);
 }
 
@@ -191,7 +220,7 @@ bool rcp_typedefinition_set_option_stringlist(rcp_typedefinition* typedefinition
     if (typedefinition == NULL) return false;
 
     // put locally created stringlist
-    rcp_option_put_stringlist(rcp_option_get_create(&typedefinition->options, prefix),
+    rcp_option_put_stringlist(_get_create_option(typedefinition, prefix),
                               rcp_stringlist_create_args(count, args));
 
     return true;
@@ -201,7 +230,7 @@ bool rcp_typedefinition_set_option_stringlist(rcp_typedefinition* typedefinition
 bool rcp_typedefinition_set_option_data(rcp_typedefinition* typedefinition, char prefix, const char* data, size_t size, bool sizeprefixed)
 {
     if (typedefinition == NULL) return false;
-    rcp_option* opt = rcp_option_get_create(&typedefinition->options, prefix);
+    rcp_option* opt = _get_create_option(typedefinition, prefix);
     return rcp_option_set_data(opt, (void*)data, size, sizeprefixed);
 }
 
@@ -502,7 +531,7 @@ const char* rcp_typedefinition_parse_number_value(rcp_typedefinition* typedefini
     return NULL;
 }
 
-const char* rcp_typedefinition_parse_string_value(rcp_typedefinition* typedefinition, const char* data, size_t* size, rcp_option* opt)
+const char* rcp_typedefinition_parse_string_value(rcp_typedefinition* typedefinition, const char* data, size_t* size, rcp_option* opt, bool borrow)
 {
     if (typedefinition == NULL) return data;
 
@@ -510,25 +539,11 @@ const char* rcp_typedefinition_parse_string_value(rcp_typedefinition* typedefini
 
     if (typedefinition->type_id == DATATYPE_STRING)
     {
-        rcp_option_free_data(opt);
-        char* string_value = NULL;
-        uint32_t str_len = 0;
-        data = rcp_read_long_string(data, size, &string_value, &str_len);
-        if (data == NULL) return NULL;
-
-        rcp_option_move_string(opt, string_value, LONG_STRING);
-        return data;
+        return rcp_read_string_into_option(opt, data, size, LONG_STRING, borrow);
     }
     else if (typedefinition->type_id == DATATYPE_ENUM)
     {
-        rcp_option_free_data(opt);
-        char* string_value = NULL;
-        uint8_t str_len = 0;
-        data = rcp_read_tiny_string(data, size, &string_value, &str_len);
-        if (data == NULL) return NULL;
-
-        rcp_option_move_string(opt, string_value, TINY_STRING);
-        return data;
+        return rcp_read_string_into_option(opt, data, size, TINY_STRING, borrow);
     }
 
     RCP_TYPEDEFINITION_DEBUG("wrong type: did not read value!");
@@ -592,24 +607,24 @@ const char* parse_number_type_option(rcp_typedefinition* typedefinition, const c
     switch (number_option)
     {
     case NUMBER_OPTIONS_DEFAULT:
-        opt = rcp_option_get_create(&typedefinition->options, NUMBER_OPTIONS_DEFAULT);
+        opt = _get_create_option(typedefinition, NUMBER_OPTIONS_DEFAULT);
         return rcp_typedefinition_parse_number_value(typedefinition, data, size, opt);
 
     case NUMBER_OPTIONS_MINIMUM:
-        opt = rcp_option_get_create(&typedefinition->options, NUMBER_OPTIONS_MINIMUM);
+        opt = _get_create_option(typedefinition, NUMBER_OPTIONS_MINIMUM);
         return rcp_typedefinition_parse_number_value(typedefinition, data, size, opt);
 
     case NUMBER_OPTIONS_MAXIMUM:
-        opt = rcp_option_get_create(&typedefinition->options, NUMBER_OPTIONS_MAXIMUM);
+        opt = _get_create_option(typedefinition, NUMBER_OPTIONS_MAXIMUM);
         return rcp_typedefinition_parse_number_value(typedefinition, data, size, opt);
 
     case NUMBER_OPTIONS_MULTIPLEOF:
-        opt = rcp_option_get_create(&typedefinition->options, NUMBER_OPTIONS_MULTIPLEOF);
+        opt = _get_create_option(typedefinition, NUMBER_OPTIONS_MULTIPLEOF);
         return rcp_typedefinition_parse_number_value(typedefinition, data, size, opt);
 
     case NUMBER_OPTIONS_SCALE:
     {
-        opt = rcp_option_get_create(&typedefinition->options, NUMBER_OPTIONS_SCALE);
+        opt = _get_create_option(typedefinition, NUMBER_OPTIONS_SCALE);
         rcp_option_free_data(opt);
         int8_t val;
         const char* t = rcp_read_i8(data, size, &val);
@@ -626,7 +641,7 @@ const char* parse_number_type_option(rcp_typedefinition* typedefinition, const c
 }
 
 
-const char* parse_string_type_option(rcp_typedefinition* typedefinition, const char* data, size_t* size, rcp_string_options option)
+const char* parse_string_type_option(rcp_typedefinition* typedefinition, const char* data, size_t* size, rcp_string_options option, bool borrow)
 {
     if (typedefinition == NULL) return NULL;
 
@@ -637,18 +652,18 @@ const char* parse_string_type_option(rcp_typedefinition* typedefinition, const c
     switch (option)
     {
     case STRING_OPTIONS_DEFAULT:
-        opt = rcp_option_get_create(&typedefinition->options, STRING_OPTIONS_DEFAULT);
-        return rcp_typedefinition_parse_string_value(typedefinition, data, size, opt);
+        opt = _get_create_option(typedefinition, STRING_OPTIONS_DEFAULT);
+        return rcp_typedefinition_parse_string_value(typedefinition, data, size, opt, borrow);
 
     case STRING_OPTIONS_REGULAR_EXPRESSION:
-        opt = rcp_option_get_create(&typedefinition->options, STRING_OPTIONS_REGULAR_EXPRESSION);
-        return rcp_typedefinition_parse_string_value(typedefinition, data, size, opt);
+        opt = _get_create_option(typedefinition, STRING_OPTIONS_REGULAR_EXPRESSION);
+        return rcp_typedefinition_parse_string_value(typedefinition, data, size, opt, borrow);
     }
 
     return NULL;
 }
 
-const char* parse_enum_type_option(rcp_typedefinition* typedefinition, const char* data, size_t* size, rcp_enum_options option)
+const char* parse_enum_type_option(rcp_typedefinition* typedefinition, const char* data, size_t* size, rcp_enum_options option, bool borrow)
 {
     if (typedefinition == NULL) return NULL;
 
@@ -658,15 +673,15 @@ const char* parse_enum_type_option(rcp_typedefinition* typedefinition, const cha
     {
     case ENUM_OPTIONS_DEFAULT:
     {
-        rcp_option* opt = rcp_option_get_create(&typedefinition->options, ENUM_OPTIONS_DEFAULT);
-        return rcp_typedefinition_parse_string_value(typedefinition, data, size, opt);
+        rcp_option* opt = _get_create_option(typedefinition, ENUM_OPTIONS_DEFAULT);
+        return rcp_typedefinition_parse_string_value(typedefinition, data, size, opt, borrow);
     }
 
     case ENUM_OPTIONS_MULTISELECT:
     {
         if (*size >= 1)
         {
-            rcp_option* opt = rcp_option_get_create(&typedefinition->options, ENUM_OPTIONS_MULTISELECT);
+            rcp_option* opt = _get_create_option(typedefinition, ENUM_OPTIONS_MULTISELECT);
 
             if (opt == NULL)
             {
@@ -685,13 +700,15 @@ const char* parse_enum_type_option(rcp_typedefinition* typedefinition, const cha
 
     case ENUM_OPTIONS_ENTRIES:
     {
+        if (*size < 1) return NULL;
+
         if (*data == RCP_TERMINATOR)
         {
             // skip if there are no entries
             *size -= 1;
             return data + 1;
         }
-        rcp_option* opt = rcp_option_get_create(&typedefinition->options, ENUM_OPTIONS_ENTRIES);
+        rcp_option* opt = _get_create_option(typedefinition, ENUM_OPTIONS_ENTRIES);
         return rcp_typedefinition_parse_stringlist_value(typedefinition, data, size, opt);
     }
     }
@@ -709,7 +726,7 @@ static const char* parse_bool_type_option(rcp_typedefinition* typedefinition, co
 
     if (option == RCP_OPTIONS_DEFAULT)
     {
-        opt = rcp_option_get_create(&typedefinition->options, RCP_OPTIONS_DEFAULT);
+        opt = _get_create_option(typedefinition, RCP_OPTIONS_DEFAULT);
         return rcp_typedefinition_parse_number_value(typedefinition, data, size, opt);
     }
 
@@ -726,7 +743,7 @@ static const char* parse_ipv4_type_option(rcp_typedefinition* typedefinition, co
 
     if (option == IPV4_OPTIONS_DEFAULT)
     {
-        opt = rcp_option_get_create(&typedefinition->options, IPV4_OPTIONS_DEFAULT);
+        opt = _get_create_option(typedefinition, IPV4_OPTIONS_DEFAULT);
         return rcp_typedefinition_parse_number_value(typedefinition, data, size, opt);
     }
 
@@ -745,7 +762,7 @@ static const char* parse_custom_type_option(rcp_typedefinition_custom* typedefin
     {
         if (*size >= typedefinition->size)
         {
-            rcp_option* opt = rcp_option_get_create(&typedefinition->default_typedefinition.options, CUSTOMTYPE_OPTIONS_DEFAULT);
+            rcp_option* opt = _get_create_option(&typedefinition->default_typedefinition, CUSTOMTYPE_OPTIONS_DEFAULT);
 
             if (opt == NULL)
             {
@@ -764,7 +781,7 @@ static const char* parse_custom_type_option(rcp_typedefinition_custom* typedefin
     {
         if (*size >= RCP_CUSTOMTYPE_UUID_LENGTH)
         {
-            rcp_option* opt = rcp_option_get_create(&typedefinition->default_typedefinition.options, CUSTOMTYPE_OPTIONS_UUID);
+            rcp_option* opt = _get_create_option(&typedefinition->default_typedefinition, CUSTOMTYPE_OPTIONS_UUID);
 
             if (opt == NULL)
             {
@@ -791,7 +808,7 @@ static const char* parse_custom_type_option(rcp_typedefinition_custom* typedefin
             return NULL;
         }
 
-        rcp_option* opt = rcp_option_get_create(&typedefinition->default_typedefinition.options, CUSTOMTYPE_OPTIONS_CONFIG);
+        rcp_option* opt = _get_create_option(&typedefinition->default_typedefinition, CUSTOMTYPE_OPTIONS_CONFIG);
 
         if (opt == NULL)
         {
@@ -809,7 +826,7 @@ static const char* parse_custom_type_option(rcp_typedefinition_custom* typedefin
     return NULL;
 }
 
-const char* rcp_typedefinition_parse_type_options(rcp_typedefinition* typedefinition, const char* data, size_t* size)
+const char* rcp_typedefinition_parse_type_options(rcp_typedefinition* typedefinition, const char* data, size_t* size, bool borrow)
 {
     if (typedefinition == NULL) return NULL;
 
@@ -874,11 +891,11 @@ const char* rcp_typedefinition_parse_type_options(rcp_typedefinition* typedefini
             break;
 
         case DATATYPE_STRING:
-            data = parse_string_type_option(typedefinition, data, size, option_prefix);
+            data = parse_string_type_option(typedefinition, data, size, option_prefix, borrow);
             break;
 
         case DATATYPE_ENUM:
-            data = parse_enum_type_option(typedefinition, data, size, option_prefix);
+            data = parse_enum_type_option(typedefinition, data, size, option_prefix, borrow);
             break;
 
 
@@ -1219,8 +1236,12 @@ void rcp_typedefinition_log(rcp_typedefinition* typedefinition)
                 break;
 
             case DATATYPE_STRING:
-                RCP_INFO("\toption: 0x%02x - %s\n", rcp_option_get_prefix(opt), rcp_option_get_string(opt, LONG_STRING));
+            {
+                size_t str_len = 0;
+                const char* str = rcp_option_get_string_view(opt, LONG_STRING, &str_len);
+                RCP_INFO("\toption: 0x%02x - %.*s\n", rcp_option_get_prefix(opt), (int)str_len, str);
                 break;
+            }
 
             case DATATYPE_ENUM:
                 switch((rcp_enum_options)rcp_option_get_prefix(opt))
@@ -37,6 +37,7 @@ extern "C"{
 #include "rcp_typedefinition_type.h"
 #include "rcp_option_type.h"
 #include "rcp_stringlist.h"
+#include "rcp_arena.h"
 
 //#define RCP_TYPEDEFINITION_DEBUG_LOG
 //#define RCP_TYPEDEFINITION_MALLOC_DEBUG_LOG
@@ -46,15 +47,17 @@ extern "C"{
 
 // create / free
 rcp_typedefinition* rcp_typedefinition_create(rcp_datatype type_id);
+rcp_typedefinition* rcp_typedefinition_create_in(rcp_datatype type_id, rcp_arena* arena); // NULL: heap
 void rcp_typedefinition_free(rcp_typedefinition* typedefinition);
 
 // type id
 rcp_datatype rcp_typedefinition_get_type_id(rcp_typedefinition* typedefinition);
 
 // parse
+// borrow: string options reference data instead of owning a copy - data has to outlive them
 const char* rcp_typedefinition_parse_number_value(rcp_typedefinition* typedefinition, const char* data, size_t* size, rcp_option* opt);
-const char* rcp_typedefinition_parse_string_value(rcp_typedefinition* typedefinition, const char* data, size_t* size, rcp_option* opt);
-const char* rcp_typedefinition_parse_type_options(rcp_typedefinition* typedefinition, const char* data, size_t* size);
+const char* rcp_typedefinition_parse_string_value(rcp_typedefinition* typedefinition, const char* data, size_t* size, rcp_option* opt, bool borrow);
+const char* rcp_typedefinition_parse_type_options(rcp_typedefinition* typedefinition, const char* data, size_t* size, bool borrow);
 
 // size and writing
 size_t rcp_typedefinition_get_size(rcp_typedefinition* typedefinition, bool all);
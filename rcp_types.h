@@ -127,7 +127,14 @@ enum rcp_command_t {
     COMMAND_UPDATE = 4,
     COMMAND_REMOVE = 5,
     COMMAND_UPDATEVALUE = 6,
-    COMMAND_MAX_
+    COMMAND_MAX_,
+
+    // rcp-c protocol extension - not part of the rabbitcontrol specification
+    // outside of the specified range - id-data: group id
+    // servers announce it in the version of INFO: 0.1.0+subscribe
+    // clients only send it to servers announcing it
+    COMMAND_SUBSCRIBE = 0x40,
+    COMMAND_UNSUBSCRIBE = 0x41
 };
 
 enum rcp_number_scale_t {
@@ -0,0 +1,158 @@
+/*
+********************************************************************
+* RabbitControl - a protocol for remote control.
+* https://rabbitcontrol.cc
+*
+* Copyright (C) 2024, Ingo Randolf
+*
+* This file is part of RabbitControl for C (rcp-c).
+*
+* rcp-c is free software: you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License,
+* or (at your option) any later version.
+*
+* rcp-c is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+* See the GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with rcp-c. If not, see <https://www.gnu.org/licenses/>.
+*********************************************************************
+*/
+
+
+// bulk conversion against the per-element store and load macros
+// usage: rcp_endian_bench [count] [rounds]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include "rcp_endian.h"
+
+static double seconds(clock_t start)
+{
+    return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+// keep the compiler from dropping the loops
+static unsigned sink = 0;
+
+static void report(const char* name, size_t bytes, int rounds, double scalar, double bulk)
+{
+    double mb = (double)bytes * rounds / (1024.0 * 1024.0);
+
+    printf("%-10s scalar %8.1f MB/s   bulk %8.1f MB/s   %5.2fx\n",
+           name,
+           scalar > 0 ? mb / scalar : 0,
+           bulk > 0 ? mb / bulk : 0,
+           bulk > 0 ? scalar / bulk : 0);
+}
+
+int main(int argc, char** argv)
+{
+    size_t count = argc > 1 ? (size_t)atol(argv[1]) : 65536;
+    int rounds = argc > 2 ? atoi(argv[2]) : 2000;
+
+    if (count == 0 || rounds <= 0) return 1;
+
+    float* values = malloc(count * sizeof(float));
+    double* doubles = malloc(count * sizeof(double));
+    char* data = malloc(count * sizeof(double));
+
+    if (values == NULL || doubles == NULL || data == NULL) return 1;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        values[i] = (float)i * 0.5f;
+        doubles[i] = (double)i * 0.25;
+    }
+
+    clock_t start;
+    double scalar;
+    double bulk;
+
+    // store f32
+    start = clock();
+    for (int r = 0; r < rounds; r++)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            uint32_t v;
+            memcpy(&v, &values[i], 4);
+            _rcp_store32(data + i * 4, v);
+        }
+        sink += (unsigned char)data[r % count];
+    }
+    scalar = seconds(start);
+
+    start = clock();
+    for (int r = 0; r < rounds; r++)
+    {
+        rcp_store_be_u32_array(data, values, count);
+        sink += (unsigned char)data[r % count];
+    }
+    bulk = seconds(start);
+
+    report("store f32", count * 4, rounds, scalar, bulk);
+
+    // load f32
+    start = clock();
+    for (int r = 0; r < rounds; r++)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            uint32_t v;
+            _rcp_load32(uint32_t, data + i * 4, &v);
+            memcpy(&values[i], &v, 4);
+        }
+        sink += (unsigned)values[r % count];
+    }
+    scalar = seconds(start);
+
+    start = clock();
+    for (int r = 0; r < rounds; r++)
+    {
+        rcp_load_be_u32_array(values, data, count);
+        sink += (unsigned)values[r % count];
+    }
+    bulk = seconds(start);
+
+    report("load f32", count * 4, rounds, scalar, bulk);
+
+    // store f64
+    start = clock();
+    for (int r = 0; r < rounds; r++)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            uint64_t v;
+            memcpy(&v, &doubles[i], 8);
+            _rcp_store64(data + i * 8, v);
+        }
+        sink += (unsigned char)data[r % count];
+    }
+    scalar = seconds(start);
+
+    start = clock();
+    for (int r = 0; r < rounds; r++)
+    {
+        rcp_store_be_u64_array(data, doubles, count);
+        sink += (unsigned char)data[r % count];
+    }
+    bulk = seconds(start);
+
+    report("store f64", count * 8, rounds, scalar, bulk);
+
+    printf("(%u)\n", sink);
+
+    free(values);
+    free(doubles);
+    free(data);
+
+    return 0;
+}
@@ -0,0 +1,172 @@
+/*
+********************************************************************
+* RabbitControl - a protocol for remote control.
+* https://rabbitcontrol.cc
+*
+* Copyright (C) 2024, Ingo Randolf
+*
+* This file is part of RabbitControl for C (rcp-c).
+*
+* rcp-c is free software: you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License,
+* or (at your option) any later version.
+*
+* rcp-c is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+* See the GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with rcp-c. If not, see <https://www.gnu.org/licenses/>.
+*********************************************************************
+*/
+
+
+// bulk conversion has to match the scalar load and store macros
+// for any count - simd blocks and remainder - and unaligned pointers
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "rcp_endian.h"
+
+#define MAX_COUNT 70
+#define MAX_OFFSET 8
+#define BUFFER_SIZE (MAX_COUNT * 8 + MAX_OFFSET + 16)
+#define GUARD 0xa5
+
+static int failed = 0;
+static int checked = 0;
+
+// scalar reference
+static void store_scalar(char* dst, const char* src, size_t count, size_t width)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        if (width == 2)
+        {
+            uint16_t v;
+            memcpy(&v, src + i * 2, 2);
+            _rcp_store16(dst + i * 2, v);
+        }
+        else if (width == 4)
+        {
+            uint32_t v;
+            memcpy(&v, src + i * 4, 4);
+            _rcp_store32(dst + i * 4, v);
+        }
+        else
+        {
+            uint64_t v;
+            memcpy(&v, src + i * 8, 8);
+            _rcp_store64(dst + i * 8, v);
+        }
+    }
+}
+
+static void load_scalar(char* dst, const char* src, size_t count, size_t width)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        if (width == 2)
+        {
+            uint16_t v;
+            _rcp_load16(uint16_t, src + i * 2, &v);
+            memcpy(dst + i * 2, &v, 2);
+        }
+        else if (width == 4)
+        {
+            uint32_t v;
+            _rcp_load32(uint32_t, src + i * 4, &v);
+            memcpy(dst + i * 4, &v, 4);
+        }
+        else
+        {
+            uint64_t v;
+            _rcp_load64(uint64_t, src + i * 8, &v);
+            memcpy(dst + i * 8, &v, 8);
+        }
+    }
+}
+
+static void bulk(bool load, char* dst, const char* src, size_t count, size_t width)
+{
+    if (load)
+    {
+        if (width == 2) rcp_load_be_u16_array(dst, src, count);
+        else if (width == 4) rcp_load_be_u32_array(dst, src, count);
+        else rcp_load_be_u64_array(dst, src, count);
+    }
+    else
+    {
+        if (width == 2) rcp_store_be_u16_array(dst, src, count);
+        else if (width == 4) rcp_store_be_u32_array(dst, src, count);
+        else rcp_store_be_u64_array(dst, src, count);
+    }
+}
+
+static void check(bool load, size_t width, size_t count, size_t src_offset, size_t dst_offset)
+{
+    static char src[BUFFER_SIZE];
+    static char expected[BUFFER_SIZE];
+    static char result[BUFFER_SIZE];
+
+    for (size_t i = 0; i < BUFFER_SIZE; i++)
+    {
+        src[i] = (char)(i * 7 + width + count);
+    }
+
+    memset(expected, GUARD, BUFFER_SIZE);
+    memset(result, GUARD, BUFFER_SIZE);
+
+    if (load)
+    {
+        load_scalar(expected + dst_offset, src + src_offset, count, width);
+    }
+    else
+    {
+        store_scalar(expected + dst_offset, src + src_offset, count, width);
+    }
+
+    bulk(load, result + dst_offset, src + src_offset, count, width);
+
+    // including the guard bytes around the destination
+    if (memcmp(expected, result, BUFFER_SIZE) != 0)
+    {
+        printf("%s width %d count %d src offset %d dst offset %d: mismatch\n",
+               load ? "load" : "store",
+               (int)width, (int)count, (int)src_offset, (int)dst_offset);
+        failed++;
+    }
+
+    checked++;
+}
+
+int main(void)
+{
+    const size_t widths[] = { 2, 4, 8 };
+
+    for (int load = 0; load < 2; load++)
+    {
+        for (size_t w = 0; w < sizeof(widths) / sizeof(widths[0]); w++)
+        {
+            for (size_t count = 0; count <= MAX_COUNT; count++)
+            {
+                for (size_t src_offset = 0; src_offset < MAX_OFFSET; src_offset++)
+                {
+                    for (size_t dst_offset = 0; dst_offset < MAX_OFFSET; dst_offset++)
+                    {
+                        check(load, widths[w], count, src_offset, dst_offset);
+                    }
+                }
+            }
+        }
+    }
+
+    printf("%d conversions checked - %d failed\n", checked, failed);
+
+    return failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,172 @@
+/*
+********************************************************************
+* RabbitControl - a protocol for remote control.
+* https://rabbitcontrol.cc
+*
+* Copyright (C) 2024, Ingo Randolf
+*
+* This file is part of RabbitControl for C (rcp-c).
+*
+* rcp-c is free software: you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License,
+* or (at your option) any later version.
+*
+* rcp-c is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+* See the GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with rcp-c. If not, see <https://www.gnu.org/licenses/>.
+*********************************************************************
+*/
+
+// a client applying the snapshot of a server has to end up with the same tree
+// without anything to send back
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "rcp_manager.h"
+#include "rcp_packet.h"
+#include "rcp_parameter.h"
+
+static int failed = 0;
+static int checked = 0;
+
+#define CHECK(x) do { if (!(x)) { printf("%s:%d: %s: check failed: %s\n", __FILE__, __LINE__, name, #x); failed++; } } while (0)
+
+
+static rcp_parameter* add(rcp_manager* manager, rcp_parameter* parameter, rcp_group_parameter* group)
+{
+    rcp_manager_add_parameter(manager, parameter, true);
+    if (group != NULL)
+    {
+        rcp_parameter_set_parent(parameter, group);
+    }
+
+    return parameter;
+}
+
+static rcp_group_parameter* add_group(rcp_manager* manager, rcp_group_parameter* group)
+{
+    return RCP_GROUP_PARAMETER(add(manager, RCP_PARAMETER(rcp_group_parameter_create(rcp_manager_get_available_id(manager))), group));
+}
+
+static rcp_parameter* add_value(rcp_manager* manager, rcp_group_parameter* group)
+{
+    return add(manager, RCP_PARAMETER(rcp_i32_parameter_create(rcp_manager_get_available_id(manager))), group);
+}
+
+// apply packets of data like a client - returns the number of packets
+static int apply(rcp_manager* manager, const char* data, size_t size)
+{
+    int count = 0;
+    rcp_packet* packet = rcp_packet_create(COMMAND_INVALID);
+
+    while (size > 0)
+    {
+        size_t rest = 0;
+        const char* end = rcp_packet_parse(data, size, &packet, &rest);
+        if (end == NULL) break;
+
+        if (rcp_packet_get_command(packet) == COMMAND_UPDATE)
+        {
+            rcp_parameter* parameter = rcp_packet_take_parameter(packet);
+            if (parameter != NULL)
+            {
+                rcp_manager_update_parameter(manager, parameter, false);
+            }
+        }
+
+        size -= (size_t)(end - data);
+        data = end;
+        count++;
+    }
+
+    rcp_packet_free(packet);
+
+    return count;
+}
+
+// same parents on both sides
+static void check_tree(const char* name, rcp_manager* server, rcp_manager* client)
+{
+    rcp_parameter_list* pl = rcp_manager_get_paramter_list(server);
+    while (pl != NULL)
+    {
+        int16_t id = rcp_parameter_get_id(pl->parameter);
+        rcp_parameter* cached = rcp_manager_get_parameter(client, id);
+        CHECK(cached != NULL);
+
+        if (cached != NULL)
+        {
+            rcp_group_parameter* parent = rcp_parameter_get_parent(pl->parameter);
+            rcp_group_parameter* cached_parent = rcp_parameter_get_parent(cached);
+
+            if (parent == NULL)
+            {
+                CHECK(cached_parent == NULL);
+            }
+            else
+            {
+                CHECK(cached_parent != NULL);
+                if (cached_parent != NULL)
+                {
+                    CHECK(rcp_parameter_get_id(RCP_PARAMETER(cached_parent)) == rcp_parameter_get_id(RCP_PARAMETER(parent)));
+                }
+            }
+        }
+
+        pl = pl->next;
+    }
+}
+
+static void check_snapshot_tree()
+{
+    const char* name = "snapshot tree";
+
+    rcp_manager* server = rcp_manager_create(NULL);
+    rcp_manager* client = rcp_manager_create(NULL);
+
+    // children created after their groups
+    rcp_parameter* moved = add_value(server, NULL);
+    rcp_group_parameter* group = add_group(server, NULL);
+    add_value(server, group);
+    rcp_group_parameter* nested = add_group(server, group);
+    add_value(server, nested);
+    add_value(server, NULL);
+
+    // moved into a group created later
+    rcp_parameter_set_parent(moved, nested);
+
+    size_t size = 0;
+    const char* data = rcp_manager_get_snapshot(server, &size);
+    CHECK(data != NULL);
+
+    if (data != NULL)
+    {
+        // all parameters and INITIALIZE
+        CHECK(apply(client, data, size) == 7);
+        check_tree(name, server, client);
+
+        // linking parents is not a change of the client
+        CHECK(rcp_manager_get_pending_count(client) == 0);
+    }
+
+    rcp_manager_free(client);
+    rcp_manager_free(server);
+
+    checked++;
+}
+
+int main(void)
+{
+    check_snapshot_tree();
+
+    printf("%d trees checked - %d failed\n", checked, failed);
+
+    return failed > 0 ? 1 : 0;
+}
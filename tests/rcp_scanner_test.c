@@ -0,0 +1,360 @@
+/*
+********************************************************************
+* RabbitControl - a protocol for remote control.
+* https://rabbitcontrol.cc
+*
+* Copyright (C) 2024, Ingo Randolf
+*
+* This file is part of RabbitControl for C (rcp-c).
+*
+* rcp-c is free software: you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License,
+* or (at your option) any later version.
+*
+* rcp-c is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+* See the GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with rcp-c. If not, see <https://www.gnu.org/licenses/>.
+*********************************************************************
+*/
+
+// the scanner decides packet boundaries instead of the parser
+// every packet rcp_packet_write produces has to be scanned
+// to the size rcp_packet_parse consumes
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "rcp_packet.h"
+#include "rcp_parameter.h"
+#include "rcp_typedefinition.h"
+#include "rcp_infodata.h"
+#include "rcp_scanner.h"
+
+static int failed = 0;
+static int checked = 0;
+
+#define CHECK(x) do { if (!(x)) { printf("%s:%d: %s: check failed: %s\n", __FILE__, __LINE__, name, #x); failed++; } } while (0)
+
+
+static size_t parse_size(const char* data, size_t size, rcp_packet** packet)
+{
+    size_t rest = 0;
+    const char* end = rcp_packet_parse(data, size, packet, &rest);
+    if (end == NULL) return 0;
+
+    return (size_t)(end - data);
+}
+
+static void check_data(const char* name, const char* data, size_t size)
+{
+    rcp_scan_info info;
+    rcp_packet* packet = rcp_packet_create(COMMAND_INVALID);
+
+    // whole packet
+    CHECK(rcp_scanner_scan_packet(data, size, &info));
+    CHECK(info.size == size);
+    CHECK(info.command == (unsigned char)data[0]);
+    CHECK(parse_size(data, size, &packet) == size);
+    CHECK(rcp_packet_get_command(packet) == info.command);
+
+    rcp_parameter* parameter = rcp_packet_get_parameter(packet);
+    if (parameter != NULL)
+    {
+        CHECK(info.id == rcp_parameter_get_id(parameter));
+        CHECK(info.type_id == RCP_TYPE_ID(parameter));
+    }
+    else if (info.command == COMMAND_INITIALIZE
+             || info.command == COMMAND_DISCOVER
+             || info.command == COMMAND_REMOVE)
+    {
+        CHECK(info.id == rcp_packet_get_iddata(packet));
+    }
+
+    // followed by more data
+    char* more = malloc(size + 8);
+    memcpy(more, data, size);
+    memset(more + size, COMMAND_INFO, 8);
+
+    CHECK(rcp_scanner_scan_packet(more, size + 8, &info));
+    CHECK(info.size == size);
+    CHECK(parse_size(more, size + 8, &packet) == size);
+
+    // no truncation is a packet
+    for (size_t i = 0; i < size; i++)
+    {
+        CHECK(!rcp_scanner_scan_packet(more, i, &info));
+        CHECK(parse_size(more, i, &packet) == 0);
+    }
+
+    free(more);
+    rcp_packet_free(packet);
+
+    checked++;
+}
+
+static void check_packet(const char* name, rcp_packet* packet)
+{
+    char* data = NULL;
+    size_t size = rcp_packet_write(packet, &data, true);
+
+    CHECK(size > 0);
+    if (size > 0)
+    {
+        check_data(name, data, size);
+    }
+
+    free(data);
+}
+
+static void check_parameter(const char* name, rcp_parameter* parameter)
+{
+    rcp_packet* packet = rcp_packet_create(COMMAND_UPDATE);
+    rcp_packet_set_parameter(packet, parameter);
+
+    check_packet(name, packet);
+
+    // with timestamp
+    rcp_packet_set_timestamp(packet, 0x0102030405060708);
+    check_packet(name, packet);
+
+    // value only
+    if (rcp_parameter_is_value(parameter)
+            || rcp_parameter_is_type(parameter, DATATYPE_BANG))
+    {
+        rcp_packet_set_command(packet, COMMAND_UPDATEVALUE);
+        check_packet(name, packet);
+    }
+
+    rcp_packet_free(packet);
+    rcp_parameter_free(parameter);
+}
+
+static rcp_parameter* with_options(rcp_parameter* parameter)
+{
+    rcp_parameter_set_label(parameter, "label");
+    rcp_parameter_set_description(parameter, "a description");
+    rcp_parameter_set_tags(parameter, "tag1 tag2");
+    rcp_parameter_set_order(parameter, -3);
+    rcp_parameter_set_readonly(parameter, true);
+    rcp_parameter_copy_userdata(parameter, "\0\1\2\3\4", 5);
+    rcp_parameter_set_userid(parameter, "user-id");
+
+    return parameter;
+}
+
+static void check_parameters(void)
+{
+    const char* name = "parameters";
+
+    // value types - plain and with all options
+    for (int i = 0; i < 2; i++)
+    {
+        rcp_value_parameter* p;
+
+        p = rcp_bool_parameter_create(1);
+        rcp_parameter_set_value_bool(p, true);
+        check_parameter("bool", i ? with_options(RCP_PARAMETER(p)) : RCP_PARAMETER(p));
+
+        p = rcp_i8_parameter_create(2);
+        rcp_parameter_set_value_int8(p, -8);
+        rcp_parameter_set_min_int8(p, -10);
+        rcp_parameter_set_max_int8(p, 10);
+        rcp_parameter_set_multipleof_int8(p, 2);
+        check_parameter("i8", i ? with_options(RCP_PARAMETER(p)) : RCP_PARAMETER(p));
+
+        p = rcp_u8_parameter_create(3);
+        rcp_parameter_set_value_uint8(p, 200);
+        rcp_parameter_set_default_uint8(p, 1);
+        check_parameter("u8", i ? with_options(RCP_PARAMETER(p)) : RCP_PARAMETER(p));
+
+        p = rcp_i16_parameter_create(4);
+        rcp_parameter_set_value_int16(p, -1600);
+        rcp_parameter_set_max_int16(p, 2000);
+        check_parameter("i16", i ? with_options(RCP_PARAMETER(p)) : RCP_PARAMETER(p));
+
+        p = rcp_u16_parameter_create(5);
+        rcp_parameter_set_value_uint16(p, 60000);
+        check_parameter("u16", i ? with_options(RCP_PARAMETER(p)) : RCP_PARAMETER(p));
+
+        p = rcp_i32_parameter_create(6);
+        rcp_parameter_set_value_int32(p, -320000);
+        rcp_parameter_set_default_int32(p, 7);
+        rcp_parameter_set_min_int32(p, -400000);
+        rcp_parameter_set_max_int32(p, 400000);
+        rcp_parameter_set_number_scale(p, NUMBER_SCALE_LOGARITHMIC);
+        rcp_parameter_set_number_unit(p, "m");
+        check_parameter("i32", i ? with_options(RCP_PARAMETER(p)) : RCP_PARAMETER(p));
+
+        p = rcp_u32_parameter_create(7);
+        rcp_parameter_set_value_uint32(p, 4000000000u);
+        check_parameter("u32", i ? with_options(RCP_PARAMETER(p)) : RCP_PARAMETER(p));
+
+        p = rcp_f32_parameter_create(8);
+        rcp_parameter_set_value_float(p, 3.5f);
+        rcp_parameter_set_min_float(p, -1.f);
+        rcp_parameter_set_max_float(p, 10.f);
+        rcp_parameter_set_multipleof_float(p, 0.5f);
+        check_parameter("f32", i ? with_options(RCP_PARAMETER(p)) : RCP_PARAMETER(p));
+
+        p = rcp_vector2f32_parameter_create(9);
+        rcp_parameter_set_value_vector2f32(p, 1.f, 2.f);
+        rcp_parameter_set_min_vector2f32(p, -5.f, -5.f);
+        rcp_parameter_set_max_vector2f32(p, 5.f, 5.f);
+        check_parameter("vector2f32", i ? with_options(RCP_PARAMETER(p)) : RCP_PARAMETER(p));
+
+        p = rcp_string_parameter_create(10);
+        rcp_parameter_set_value_string(p, "some text");
+        check_parameter("string", i ? with_options(RCP_PARAMETER(p)) : RCP_PARAMETER(p));
+
+        p = rcp_string_parameter_create(11);
+        rcp_parameter_set_value_string(p, "");
+        check_parameter("empty string", i ? with_options(RCP_PARAMETER(p)) : RCP_PARAMETER(p));
+
+        p = rcp_enum_parameter_create(12);
+        rcp_parameter_set_entries_enum(p, 3, "one", "two", "three");
+        rcp_parameter_set_value_enum(p, "two");
+        rcp_parameter_set_default_enum(p, "one");
+        rcp_parameter_set_multiselect_enum(p, false);
+        check_parameter("enum", i ? with_options(RCP_PARAMETER(p)) : RCP_PARAMETER(p));
+
+        p = rcp_ipv4_parameter_create(13);
+        rcp_parameter_set_value_ipv4(p, 0xc0a80001);
+        rcp_parameter_set_default_ipv4(p, 0x7f000001);
+        check_parameter("ipv4", i ? with_options(RCP_PARAMETER(p)) : RCP_PARAMETER(p));
+
+        p = rcp_custom_parameter_create(14, 6);
+        rcp_parameter_copy_value_data(p, "abcdef", 6);
+        rcp_parameter_set_uuid(p, "0123456789abcdef", 16);
+        rcp_parameter_set_config(p, "config", 6);
+        check_parameter("custom", i ? with_options(RCP_PARAMETER(p)) : RCP_PARAMETER(p));
+
+        rcp_bang_parameter* b = rcp_bang_parameter_create(15);
+        check_parameter("bang", i ? with_options(RCP_PARAMETER(b)) : RCP_PARAMETER(b));
+
+        rcp_group_parameter* g = rcp_group_parameter_create(16);
+        check_parameter("group", i ? with_options(RCP_PARAMETER(g)) : RCP_PARAMETER(g));
+    }
+
+    // child of a group
+    rcp_group_parameter* group = rcp_group_parameter_create(20);
+    rcp_value_parameter* child = rcp_i32_parameter_create(21);
+    rcp_parameter_set_value_int32(child, 21);
+    rcp_parameter_set_parent(RCP_PARAMETER(child), group);
+    check_parameter("child", RCP_PARAMETER(child));
+    rcp_parameter_free(RCP_PARAMETER(group));
+
+    // options set to their default value are still written
+    rcp_value_parameter* defaults = rcp_i32_parameter_create(23);
+    rcp_parameter_set_value_int32(defaults, 23);
+    rcp_parameter_set_order(RCP_PARAMETER(defaults), 0);
+    rcp_parameter_set_readonly(RCP_PARAMETER(defaults), false);
+    check_parameter("default options", RCP_PARAMETER(defaults));
+
+    // no value - no value update
+    rcp_value_parameter* novalue = rcp_string_parameter_create(22);
+    rcp_packet* packet = rcp_packet_create(COMMAND_UPDATEVALUE);
+    rcp_packet_set_parameter(packet, RCP_PARAMETER(novalue));
+
+    char* data = NULL;
+    CHECK(rcp_packet_write(packet, &data, true) == 0);
+    free(data);
+
+    rcp_packet_set_command(packet, COMMAND_UPDATE);
+    check_packet("no value", packet);
+
+    rcp_packet_free(packet);
+    rcp_parameter_free(RCP_PARAMETER(novalue));
+
+    CHECK(checked > 0);
+}
+
+static void check_commands(void)
+{
+    const char* name = "commands";
+
+    // id data
+    rcp_packet_command commands[] = { COMMAND_INITIALIZE, COMMAND_DISCOVER, COMMAND_REMOVE };
+
+    for (size_t i = 0; i < sizeof(commands) / sizeof(commands[0]); i++)
+    {
+        rcp_packet* packet = rcp_packet_create(commands[i]);
+        check_packet(name, packet);
+
+        rcp_packet_set_iddata(packet, 0x1234);
+        check_packet(name, packet);
+
+        rcp_packet_free(packet);
+    }
+
+    // info
+    rcp_packet* packet = rcp_packet_create(COMMAND_INFO);
+    check_packet(name, packet);
+
+    rcp_packet_put_infodata(packet, rcp_infodata_create("0.1.0", "application"));
+    check_packet(name, packet);
+    rcp_packet_free(packet);
+}
+
+static void check_stream(void)
+{
+    const char* name = "stream";
+
+    // several packets in one buffer
+    rcp_value_parameter* s = rcp_string_parameter_create(1);
+    rcp_parameter_set_value_string(s, "text");
+    with_options(RCP_PARAMETER(s));
+
+    rcp_packet* packet = rcp_packet_create(COMMAND_UPDATE);
+    rcp_packet_set_parameter(packet, RCP_PARAMETER(s));
+
+    char* buffer = NULL;
+    size_t buffer_size = 0;
+    size_t size = rcp_packet_write_grow(packet, &buffer, &buffer_size, 0, true);
+
+    rcp_packet_set_command(packet, COMMAND_UPDATEVALUE);
+    size += rcp_packet_write_grow(packet, &buffer, &buffer_size, size, true);
+
+    rcp_packet* init = rcp_packet_create(COMMAND_INITIALIZE);
+    size += rcp_packet_write_grow(init, &buffer, &buffer_size, size, true);
+    rcp_packet_free(init);
+
+    rcp_packet* parsed = rcp_packet_create(COMMAND_INVALID);
+    size_t offset = 0;
+    int count = 0;
+
+    while (offset < size)
+    {
+        rcp_scan_info info;
+        if (!rcp_scanner_scan_packet(buffer + offset, size - offset, &info)) break;
+
+        CHECK(parse_size(buffer + offset, size - offset, &parsed) == info.size);
+
+        offset += info.size;
+        count++;
+    }
+
+    CHECK(offset == size);
+    CHECK(count == 3);
+
+    free(buffer);
+    rcp_packet_free(parsed);
+    rcp_packet_free(packet);
+    rcp_parameter_free(RCP_PARAMETER(s));
+}
+
+int main(void)
+{
+    check_parameters();
+    check_commands();
+    check_stream();
+
+    printf("%d packets checked - %d failed\n", checked, failed);
+
+    return failed > 0 ? 1 : 0;
+}
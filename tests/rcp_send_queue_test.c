@@ -0,0 +1,342 @@
+/*
+********************************************************************
+* RabbitControl - a protocol for remote control.
+* https://rabbitcontrol.cc
+*
+* Copyright (C) 2024, Ingo Randolf
+*
+* This file is part of RabbitControl for C (rcp-c).
+*
+* rcp-c is free software: you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License,
+* or (at your option) any later version.
+*
+* rcp-c is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+* See the GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with rcp-c. If not, see <https://www.gnu.org/licenses/>.
+*********************************************************************
+*/
+
+// the queue keeps packet boundaries while data is consumed in pieces
+// coalescing and dropping must never touch a packet which was partly sent
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "rcp_packet.h"
+#include "rcp_parameter.h"
+#include "rcp_send_queue.h"
+
+#define BUFFER_SIZE 1024
+
+static int failed = 0;
+static int checked = 0;
+
+#define CHECK(x) do { if (!(x)) { printf("%s:%d: %s: check failed: %s\n", __FILE__, __LINE__, name, #x); failed++; } } while (0)
+
+
+typedef struct
+{
+    char data[BUFFER_SIZE];
+    size_t size;
+} buffer;
+
+// append a packet to buf - returns its size
+static size_t append(buffer* buf, rcp_packet* packet)
+{
+    char* data = NULL;
+    size_t size = rcp_packet_write(packet, &data, true);
+
+    if (size > 0 &&
+            buf->size + size <= BUFFER_SIZE)
+    {
+        memcpy(buf->data + buf->size, data, size);
+        buf->size += size;
+    }
+
+    free(data);
+
+    return size;
+}
+
+// UPDATE or UPDATEVALUE of an i32 parameter - label: not only a value
+static size_t append_value(buffer* buf, rcp_packet_command command, int16_t id, int32_t value, const char* label)
+{
+    rcp_value_parameter* parameter = rcp_i32_parameter_create(id);
+    rcp_parameter_set_value_int32(parameter, value);
+    if (label != NULL)
+    {
+        rcp_parameter_set_label(RCP_PARAMETER(parameter), label);
+    }
+
+    rcp_packet* packet = rcp_packet_create(command);
+    rcp_packet_set_parameter(packet, RCP_PARAMETER(parameter));
+
+    size_t size = append(buf, packet);
+
+    rcp_packet_free(packet);
+    rcp_parameter_free(RCP_PARAMETER(parameter));
+
+    return size;
+}
+
+static size_t append_initialize(buffer* buf, int16_t id)
+{
+    rcp_packet* packet = rcp_packet_create(COMMAND_INITIALIZE);
+    if (id != 0)
+    {
+        rcp_packet_set_iddata(packet, id);
+    }
+
+    size_t size = append(buf, packet);
+
+    rcp_packet_free(packet);
+
+    return size;
+}
+
+// pending data of the queue equals expected
+static int check_content(rcp_send_queue* queue, const char* data, size_t size)
+{
+    size_t peek_size = 0;
+    const char* peek = rcp_send_queue_peek(queue, 0, &peek_size);
+
+    if (rcp_send_queue_get_size(queue) != size) return 0;
+    if (peek_size != size) return 0;
+    if (size == 0) return peek == NULL;
+
+    return memcmp(peek, data, size) == 0;
+}
+
+static void check_push_consume()
+{
+    const char* name = "push consume";
+    buffer buf = { { 0 }, 0 };
+
+    size_t s0 = append_value(&buf, COMMAND_UPDATEVALUE, 1, 10, NULL);
+    size_t s1 = append_value(&buf, COMMAND_UPDATE, 2, 20, "two");
+    size_t s2 = append_initialize(&buf, 0);
+
+    rcp_send_queue* queue = rcp_send_queue_create();
+
+    // several packets in one push
+    CHECK(rcp_send_queue_push(queue, buf.data, buf.size));
+    CHECK(check_content(queue, buf.data, buf.size));
+
+    // at least one packet - packets are not split
+    size_t size = 0;
+    CHECK(rcp_send_queue_peek(queue, 1, &size) != NULL);
+    CHECK(size == s0);
+    CHECK(rcp_send_queue_peek(queue, s0 + s1, &size) != NULL);
+    CHECK(size == s0 + s1);
+    CHECK(rcp_send_queue_peek(queue, s0 + s1 - 1, &size) != NULL);
+    CHECK(size == s0);
+
+    // partial consume - peek continues inside the first packet
+    rcp_send_queue_consume(queue, 2);
+    CHECK(check_content(queue, buf.data + 2, buf.size - 2));
+    CHECK(rcp_send_queue_peek(queue, 1, &size) != NULL);
+    CHECK(size == s0 - 2);
+
+    // end inside second packet
+    rcp_send_queue_consume(queue, s0 - 2 + 1);
+    CHECK(check_content(queue, buf.data + s0 + 1, s1 - 1 + s2));
+
+    rcp_send_queue_consume(queue, s1 - 1);
+    CHECK(check_content(queue, buf.data + s0 + s1, s2));
+
+    // more than pending
+    rcp_send_queue_consume(queue, s2 + 10);
+    CHECK(check_content(queue, NULL, 0));
+
+    // reusable when empty
+    CHECK(rcp_send_queue_push(queue, buf.data, s0));
+    CHECK(check_content(queue, buf.data, s0));
+
+    rcp_send_queue_free(queue);
+
+    checked++;
+}
+
+static void check_coalesce_values()
+{
+    const char* name = "coalesce values";
+    buffer in = { { 0 }, 0 };
+    buffer out = { { 0 }, 0 };
+
+    size_t dropped = append_value(&in, COMMAND_UPDATEVALUE, 1, 10, NULL);
+    append_value(&in, COMMAND_UPDATEVALUE, 2, 20, NULL);
+    append_value(&in, COMMAND_UPDATEVALUE, 1, 11, NULL);
+
+    append_value(&out, COMMAND_UPDATEVALUE, 2, 20, NULL);
+    append_value(&out, COMMAND_UPDATEVALUE, 1, 11, NULL);
+
+    rcp_send_queue* queue = rcp_send_queue_create();
+
+    // one packet per push
+    CHECK(rcp_send_queue_push(queue, in.data, dropped));
+    CHECK(rcp_send_queue_push(queue, in.data + dropped, in.size - dropped));
+
+    CHECK(rcp_send_queue_coalesce(queue) == dropped);
+    CHECK(check_content(queue, out.data, out.size));
+
+    // nothing left to coalesce
+    CHECK(rcp_send_queue_coalesce(queue) == 0);
+    CHECK(check_content(queue, out.data, out.size));
+
+    // no leftovers of the last run - id 1 only once now
+    rcp_send_queue_consume(queue, out.size);
+
+    buffer again = { { 0 }, 0 };
+    append_value(&again, COMMAND_UPDATEVALUE, 1, 12, NULL);
+    append_value(&again, COMMAND_UPDATEVALUE, 3, 30, NULL);
+
+    CHECK(rcp_send_queue_push(queue, again.data, again.size));
+    CHECK(rcp_send_queue_coalesce(queue) == 0);
+    CHECK(check_content(queue, again.data, again.size));
+
+    rcp_send_queue_free(queue);
+
+    checked++;
+}
+
+static void check_coalesce_update()
+{
+    const char* name = "coalesce update";
+    rcp_send_queue* queue = rcp_send_queue_create();
+
+    // UPDATE creates the parameter - a later UPDATEVALUE does not replace it
+    {
+        buffer in = { { 0 }, 0 };
+        append_value(&in, COMMAND_UPDATE, 1, 10, NULL);
+        append_value(&in, COMMAND_UPDATEVALUE, 1, 11, NULL);
+
+        CHECK(rcp_send_queue_push(queue, in.data, in.size));
+        CHECK(rcp_send_queue_coalesce(queue) == 0);
+        CHECK(check_content(queue, in.data, in.size));
+
+        rcp_send_queue_consume(queue, in.size);
+    }
+
+    // a later UPDATE replaces UPDATEVALUE and UPDATE
+    {
+        buffer in = { { 0 }, 0 };
+        buffer out = { { 0 }, 0 };
+        size_t dropped = append_value(&in, COMMAND_UPDATEVALUE, 1, 10, NULL);
+        dropped += append_value(&in, COMMAND_UPDATE, 1, 11, NULL);
+        append_value(&in, COMMAND_UPDATE, 1, 12, NULL);
+
+        append_value(&out, COMMAND_UPDATE, 1, 12, NULL);
+
+        CHECK(rcp_send_queue_push(queue, in.data, in.size));
+        CHECK(rcp_send_queue_coalesce(queue) == dropped);
+        CHECK(check_content(queue, out.data, out.size));
+
+        rcp_send_queue_consume(queue, out.size);
+    }
+
+    // metadata is never replaced
+    {
+        buffer in = { { 0 }, 0 };
+        append_value(&in, COMMAND_UPDATE, 1, 10, "label");
+        append_value(&in, COMMAND_UPDATE, 1, 11, NULL);
+
+        CHECK(rcp_send_queue_push(queue, in.data, in.size));
+        CHECK(rcp_send_queue_coalesce(queue) == 0);
+        CHECK(check_content(queue, in.data, in.size));
+
+        rcp_send_queue_consume(queue, in.size);
+    }
+
+    rcp_send_queue_free(queue);
+
+    checked++;
+}
+
+static void check_partly_sent()
+{
+    const char* name = "partly sent";
+    buffer in = { { 0 }, 0 };
+    buffer out = { { 0 }, 0 };
+
+    size_t s0 = append_value(&in, COMMAND_UPDATEVALUE, 1, 10, NULL);
+    size_t s1 = append_value(&in, COMMAND_UPDATEVALUE, 1, 11, NULL);
+
+    rcp_send_queue* queue = rcp_send_queue_create();
+
+    CHECK(rcp_send_queue_push(queue, in.data, in.size));
+    rcp_send_queue_consume(queue, 1);
+
+    // the started packet stays
+    CHECK(rcp_send_queue_coalesce(queue) == 0);
+    CHECK(check_content(queue, in.data + 1, in.size - 1));
+
+    // only the packet after it is replaced
+    append_value(&in, COMMAND_UPDATEVALUE, 1, 12, NULL);
+    CHECK(rcp_send_queue_push(queue, in.data + s0 + s1, in.size - s0 - s1));
+    CHECK(rcp_send_queue_coalesce(queue) == s1);
+
+    memcpy(out.data, in.data + 1, s0 - 1);
+    out.size = s0 - 1;
+    append_value(&out, COMMAND_UPDATEVALUE, 1, 12, NULL);
+    CHECK(check_content(queue, out.data, out.size));
+
+    // the same for dropping state
+    CHECK(rcp_send_queue_drop_state(queue) == out.size - (s0 - 1));
+    CHECK(check_content(queue, in.data + 1, s0 - 1));
+
+    rcp_send_queue_consume(queue, s0 - 1);
+    CHECK(check_content(queue, NULL, 0));
+
+    rcp_send_queue_free(queue);
+
+    checked++;
+}
+
+static void check_drop_state()
+{
+    const char* name = "drop state";
+    buffer in = { { 0 }, 0 };
+    buffer out = { { 0 }, 0 };
+
+    size_t dropped = append_value(&in, COMMAND_UPDATEVALUE, 1, 10, NULL);
+    append_initialize(&in, 5);
+    dropped += append_value(&in, COMMAND_UPDATE, 2, 20, "two");
+    append_initialize(&in, 0);
+
+    // INITIALIZE ends a response - it is kept
+    append_initialize(&out, 5);
+    append_initialize(&out, 0);
+
+    rcp_send_queue* queue = rcp_send_queue_create();
+
+    CHECK(rcp_send_queue_push(queue, in.data, in.size));
+    CHECK(rcp_send_queue_drop_state(queue) == dropped);
+    CHECK(check_content(queue, out.data, out.size));
+
+    CHECK(rcp_send_queue_drop_state(queue) == 0);
+    CHECK(check_content(queue, out.data, out.size));
+
+    rcp_send_queue_free(queue);
+
+    checked++;
+}
+
+int main(void)
+{
+    check_push_consume();
+    check_coalesce_values();
+    check_coalesce_update();
+    check_partly_sent();
+    check_drop_state();
+
+    printf("%d queues checked - %d failed\n", checked, failed);
+
+    return failed > 0 ? 1 : 0;
+}
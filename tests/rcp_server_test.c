@@ -0,0 +1,232 @@
+/*
+********************************************************************
+* RabbitControl - a protocol for remote control.
+* https://rabbitcontrol.cc
+*
+* Copyright (C) 2024, Ingo Randolf
+*
+* This file is part of RabbitControl for C (rcp-c).
+*
+* rcp-c is free software: you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License,
+* or (at your option) any later version.
+*
+* rcp-c is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+* See the GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with rcp-c. If not, see <https://www.gnu.org/licenses/>.
+*********************************************************************
+*/
+
+// the queue of a slow client stays within its budget plus one frame
+// also while its state is resent - and the client ends up with the state of the server
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "rcp_server.h"
+#include "rcp_manager.h"
+#include "rcp_packet.h"
+#include "rcp_parameter.h"
+
+#define PARAMETER_COUNT 100
+#define QUEUE_SIZE 256
+#define FRAME_SIZE 128
+
+static int failed = 0;
+static int checked = 0;
+
+#define CHECK(x) do { if (!(x)) { printf("%s:%d: %s: check failed: %s\n", __FILE__, __LINE__, name, #x); failed++; } } while (0)
+
+
+// a message based link to one client - accepts all or nothing
+typedef struct
+{
+    rcp_server_transporter transporter;
+    rcp_manager* client;
+    size_t credit;
+    int initialized;
+} client_link;
+
+// apply packets of data like a client
+static void apply(client_link* l, const char* data, size_t size)
+{
+    rcp_packet* packet = rcp_packet_create(COMMAND_INVALID);
+
+    while (size > 0)
+    {
+        size_t rest = 0;
+        const char* end = rcp_packet_parse(data, size, &packet, &rest);
+        if (end == NULL) break;
+
+        rcp_packet_command command = rcp_packet_get_command(packet);
+        if (command == COMMAND_INITIALIZE)
+        {
+            l->initialized++;
+        }
+        else if (command == COMMAND_UPDATE ||
+                 command == COMMAND_UPDATEVALUE)
+        {
+            rcp_parameter* parameter = rcp_packet_take_parameter(packet);
+            if (parameter != NULL)
+            {
+                // values of unknown parameters are ignored
+                if (command == COMMAND_UPDATEVALUE &&
+                        rcp_manager_get_parameter(l->client, rcp_parameter_get_id(parameter)) == NULL)
+                {
+                    rcp_parameter_free(parameter);
+                }
+                else if (!rcp_manager_update_parameter(l->client, parameter, false))
+                {
+                    // merged into the cached parameter
+                    rcp_parameter_free(parameter);
+                }
+            }
+        }
+
+        size -= (size_t)(end - data);
+        data = end;
+    }
+
+    rcp_packet_free(packet);
+}
+
+static void send_to_one(rcp_server_transporter* transporter, const char* data, size_t size, void* id)
+{
+    (void)id;
+    apply((client_link*)transporter, data, size);
+}
+
+static void send_to_all(rcp_server_transporter* transporter, const char* data, size_t size, void* excludeId)
+{
+    (void)excludeId;
+    apply((client_link*)transporter, data, size);
+}
+
+static size_t try_send_to_one(rcp_server_transporter* transporter, const char* data, size_t size, void* id)
+{
+    (void)id;
+
+    client_link* l = (client_link*)transporter;
+    if (size > l->credit)
+    {
+        return 0;
+    }
+
+    l->credit -= size;
+    apply(l, data, size);
+
+    return size;
+}
+
+static void receive(client_link* l, rcp_packet_command command)
+{
+    rcp_packet* packet = rcp_packet_create(command);
+    char* data = NULL;
+    size_t size = rcp_packet_write(packet, &data, false);
+
+    rcp_server_transporter_call_recv_cb(&l->transporter, data, size, l);
+
+    free(data);
+    rcp_packet_free(packet);
+}
+
+static void check_slow_client()
+{
+    const char* name = "slow client";
+
+    client_link l;
+    memset(&l, 0, sizeof(client_link));
+    l.client = rcp_manager_create(NULL);
+
+    rcp_server_transporter_setup(&l.transporter, send_to_one, send_to_all);
+    rcp_server_transporter_set_try_send(&l.transporter, try_send_to_one);
+
+    rcp_server* server = rcp_server_create(&l.transporter);
+    rcp_manager_set_max_frame_size(rcp_server_get_manager(server), FRAME_SIZE);
+    rcp_server_set_client_queue_size(server, QUEUE_SIZE);
+
+    rcp_group_parameter* groups[2];
+    groups[0] = rcp_server_create_group(server, "g", NULL);
+    groups[1] = rcp_server_create_group(server, "h", groups[0]);
+
+    rcp_value_parameter* parameters[PARAMETER_COUNT];
+    for (int i = 0; i < PARAMETER_COUNT; i++)
+    {
+        parameters[i] = rcp_server_expose_i32(server, "value", groups[i % 2]);
+    }
+    rcp_server_update(server);
+
+    // the whole state does not fit - it is resent while the queue drains
+    receive(&l, COMMAND_INFO);
+    receive(&l, COMMAND_INITIALIZE);
+    CHECK(rcp_server_get_client_queue_pending(server, &l) <= QUEUE_SIZE + FRAME_SIZE);
+
+    size_t max_pending = 0;
+    for (int32_t round = 1; round <= 20; round++)
+    {
+        l.credit = 40;
+
+        for (int i = 0; i < PARAMETER_COUNT; i++)
+        {
+            rcp_parameter_set_value_int32(parameters[i], round * 1000 + i);
+        }
+        rcp_server_update(server);
+
+        size_t pending = rcp_server_get_client_queue_pending(server, &l);
+        if (pending > max_pending)
+        {
+            max_pending = pending;
+        }
+    }
+
+    CHECK(max_pending <= QUEUE_SIZE + FRAME_SIZE);
+
+    // link is fast again
+    for (int i = 0; i < 100 && rcp_server_get_client_queue_pending(server, &l) > 0; i++)
+    {
+        l.credit = QUEUE_SIZE;
+        rcp_server_update(server);
+    }
+
+    CHECK(rcp_server_get_client_queue_pending(server, &l) == 0);
+    CHECK(l.initialized == 1);
+
+    for (int i = 0; i < PARAMETER_COUNT; i++)
+    {
+        rcp_parameter* parameter = RCP_PARAMETER(parameters[i]);
+        rcp_parameter* cached = rcp_manager_get_parameter(l.client, rcp_parameter_get_id(parameter));
+        CHECK(cached != NULL);
+
+        if (cached != NULL)
+        {
+            CHECK(rcp_parameter_get_value_int32(RCP_VALUE_PARAMETER(cached)) == 20 * 1000 + i);
+
+            rcp_group_parameter* parent = rcp_parameter_get_parent(cached);
+            CHECK(parent != NULL);
+            if (parent != NULL)
+            {
+                CHECK(rcp_parameter_get_id(RCP_PARAMETER(parent)) == rcp_parameter_get_id(RCP_PARAMETER(groups[i % 2])));
+            }
+        }
+    }
+
+    rcp_server_free(server);
+    rcp_manager_free(l.client);
+
+    checked++;
+}
+
+int main(void)
+{
+    check_slow_client();
+
+    printf("%d servers checked - %d failed\n", checked, failed);
+
+    return failed > 0 ? 1 : 0;
+}